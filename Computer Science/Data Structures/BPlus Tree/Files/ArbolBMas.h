@@ -0,0 +1,611 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Árbol B+ con la misma interfaz que ArbolRojiNegro, pensado para la caché:
+cada nodo guarda muchas claves contiguas, así que una búsqueda toca unos
+pocos nodos (la altura de un árbol de 10^7 claves int es 4 o 5) en lugar de
+un nodo por nivel de un árbol binario.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+#ifndef ARBOLBMAS_H
+#define ARBOLBMAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Claves por nodo: las que caben en 256 bytes (cuatro líneas de caché),
+// con un mínimo de 8. Con int son 64
+template <class Clave>
+struct ClavesPorNodo {
+    static const int valor = 256 / sizeof(Clave) < 8 ? 8 : (int)(256 / sizeof(Clave));
+};
+
+// Cuántas de las n claves ordenadas son menores que k (la posición donde
+// iría k). La versión general es una búsqueda binaria
+template <class Clave, class Comparar>
+struct BuscadorEnNodo {
+    static int menores(const Clave* claves, int n, const Clave& k, const Comparar& comp) {
+        int inicio = 0, fin = n;
+        while (inicio < fin) {
+            int medio = (inicio + fin) / 2;
+            if (comp(claves[medio], k))
+                inicio = medio + 1;
+            else
+                fin = medio;
+        }
+        return inicio;
+    }
+};
+
+#if defined(__SSE2__)
+// Con int y el orden normal se comparan cuatro claves por instrucción y se
+// suman los resultados (cada comparación verdadera vale -1), sin saltos que
+// dependan de las claves: en un nodo ordenado, las menores que k son
+// justamente su posición
+template <>
+struct BuscadorEnNodo<int, less<int> > {
+    static int menores(const int* claves, int n, const int& k, const less<int>&) {
+        __m128i clave = _mm_set1_epi32(k);
+        __m128i cuenta = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i bloque = _mm_loadu_si128((const __m128i*)(claves + i));
+            cuenta = _mm_sub_epi32(cuenta, _mm_cmplt_epi32(bloque, clave));
+        }
+        int parciales[4];
+        _mm_storeu_si128((__m128i*)parciales, cuenta);
+        int total = parciales[0] + parciales[1] + parciales[2] + parciales[3];
+        for (; i < n; i++)
+            total += claves[i] < k ? 1 : 0;
+        return total;
+    }
+};
+#endif
+
+// Clase del Árbol B+
+//
+// Clave, Valor, Comparar: como en ArbolRojiNegro
+// CLAVES: claves por nodo (al menos 4)
+//
+// - Todas las entradas (clave, información) están en las hojas, ordenadas y
+//   enlazadas entre sí en ambos sentidos: el inorden y las consultas por
+//   rango avanzan de hoja en hoja sin volver a subir.
+// - Los nodos internos solo guardan separadores: el hijo i tiene las claves
+//   en [claves[i - 1], claves[i]).
+// - Todo nodo salvo la raíz tiene entre CLAVES / 2 y CLAVES claves, y todas
+//   las hojas están a la misma profundidad.
+// - Las claves son únicas: insertar una clave que ya está reemplaza su
+//   información (ArbolRojiNegro admite repetidas).
+template <class Clave = int, class Valor = string, class Comparar = less<Clave>,
+          int CLAVES = ClavesPorNodo<Clave>::valor>
+class ArbolBMas {
+private:
+    static const int MINIMO = CLAVES / 2;
+    static const int MAX_ALTURA = 32;
+
+    // Cada nodo empieza en una línea de caché y ocupa un número entero de
+    // ellas; las claves van al principio para recorrerlas de corrido
+    struct alignas(64) Nodo {
+        Clave claves[CLAVES];
+        int cuenta; // claves en uso
+    };
+
+    struct Hoja : Nodo {
+        Hoja* ant;
+        Hoja* sig;
+        Valor infos[CLAVES];
+    };
+
+    struct Interno : Nodo {
+        Nodo* hijos[CLAVES + 1];
+    };
+
+    Nodo* raiz;
+    int altura; // niveles; 1 = la raíz es una hoja
+    size_t tam;
+    Comparar comp;
+
+    // Métodos
+
+    // new no respeta alignas(64) antes de C++17: se reserva de más y se
+    // guarda el puntero original justo antes del nodo alineado
+    static void* reservarAlineado(size_t bytes) {
+        char* bruto = static_cast<char*>(::operator new(bytes + 64));
+        char* alineado = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(bruto) + 64) & ~(uintptr_t)63);
+        reinterpret_cast<void**>(alineado)[-1] = bruto;
+        return alineado;
+    }
+
+    static void liberarAlineado(void* p) {
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    Hoja* crearHoja() {
+        Hoja* h = new (reservarAlineado(sizeof(Hoja))) Hoja();
+        h->cuenta = 0;
+        h->ant = h->sig = nullptr;
+        return h;
+    }
+
+    Interno* crearInterno() {
+        Interno* in = new (reservarAlineado(sizeof(Interno))) Interno();
+        in->cuenta = 0;
+        return in;
+    }
+
+    void borrarHoja(Hoja* h) {
+        h->~Hoja();
+        liberarAlineado(h);
+    }
+
+    void borrarInterno(Interno* in) {
+        in->~Interno();
+        liberarAlineado(in);
+    }
+
+    int menores(const Nodo* n, const Clave& clave) const {
+        return BuscadorEnNodo<Clave, Comparar>::menores(n->claves, n->cuenta, clave, comp);
+    }
+
+    // Hijo que cubre la clave: el primero cuyo separador es mayor que ella
+    int hijoPara(const Interno* in, const Clave& clave) const {
+        int i = menores(in, clave);
+        if (i < in->cuenta && !comp(clave, in->claves[i]))
+            i++;
+        return i;
+    }
+
+    // Baja hasta la hoja de la clave, anotando el camino si se pide
+    Hoja* bajar(const Clave& clave, Interno** camino, int* indices) const {
+        Nodo* n = raiz;
+        for (int nivel = 0; nivel < altura - 1; nivel++) {
+            Interno* in = static_cast<Interno*>(n);
+            int i = hijoPara(in, clave);
+            if (camino != nullptr) {
+                camino[nivel] = in;
+                indices[nivel] = i;
+            }
+            n = in->hijos[i];
+        }
+        return static_cast<Hoja*>(n);
+    }
+
+    Hoja* primeraHoja() const {
+        Nodo* n = raiz;
+        for (int nivel = 0; nivel < altura - 1; nivel++)
+            n = static_cast<Interno*>(n)->hijos[0];
+        return static_cast<Hoja*>(n);
+    }
+
+    // Información de la clave o nullptr si no está
+    const Valor* ubicar(const Clave& clave) const {
+        Hoja* h = bajar(clave, nullptr, nullptr);
+        int pos = menores(h, clave);
+        if (pos < h->cuenta && !comp(clave, h->claves[pos]))
+            return &h->infos[pos];
+        return nullptr;
+    }
+
+    // Corrimientos dentro de un nodo
+
+    void insertarEnHoja(Hoja* h, int pos, const Clave& clave, const Valor& info) {
+        for (int j = h->cuenta; j > pos; j--) {
+            h->claves[j] = std::move(h->claves[j - 1]);
+            h->infos[j] = std::move(h->infos[j - 1]);
+        }
+        h->claves[pos] = clave;
+        h->infos[pos] = info;
+        h->cuenta++;
+    }
+
+    void quitarDeHoja(Hoja* h, int pos) {
+        for (int j = pos; j + 1 < h->cuenta; j++) {
+            h->claves[j] = std::move(h->claves[j + 1]);
+            h->infos[j] = std::move(h->infos[j + 1]);
+        }
+        h->cuenta--;
+        h->infos[h->cuenta] = Valor(); // no retener memoria de la información
+    }
+
+    // Inserta el separador en la posición i con su hijo derecho
+    void insertarEnInterno(Interno* in, int i, const Clave& separador, Nodo* derecho) {
+        for (int j = in->cuenta; j > i; j--) {
+            in->claves[j] = std::move(in->claves[j - 1]);
+            in->hijos[j + 1] = in->hijos[j];
+        }
+        in->claves[i] = separador;
+        in->hijos[i + 1] = derecho;
+        in->cuenta++;
+    }
+
+    // Quita el separador i y su hijo derecho (i + 1)
+    void quitarDeInterno(Interno* in, int i) {
+        for (int j = i; j + 1 < in->cuenta; j++) {
+            in->claves[j] = std::move(in->claves[j + 1]);
+            in->hijos[j + 1] = in->hijos[j + 2];
+        }
+        in->cuenta--;
+    }
+
+    // Divide una hoja llena al insertar: la mitad superior pasa a una hoja
+    // nueva, enlazada a la derecha. Devuelve la hoja nueva
+    Hoja* dividirHoja(Hoja* h, int pos, const Clave& clave, const Valor& info) {
+        Hoja* nueva = crearHoja();
+        int mover = CLAVES / 2;
+        int quedan = CLAVES - mover;
+        for (int j = 0; j < mover; j++) {
+            nueva->claves[j] = std::move(h->claves[quedan + j]);
+            nueva->infos[j] = std::move(h->infos[quedan + j]);
+            h->infos[quedan + j] = Valor();
+        }
+        nueva->cuenta = mover;
+        h->cuenta = quedan;
+
+        // ... <-> [h] <-> [nueva] <-> [sig] <-> ...
+        nueva->sig = h->sig;
+        if (h->sig != nullptr) h->sig->ant = nueva;
+        nueva->ant = h;
+        h->sig = nueva;
+
+        if (pos <= quedan)
+            insertarEnHoja(h, pos, clave, info);
+        else
+            insertarEnHoja(nueva, pos - quedan, clave, info);
+        return nueva;
+    }
+
+    // Divide un interno lleno al insertar el separador en i. La clave del
+    // medio sube (queda en separador) y la mitad derecha pasa a un nodo nuevo
+    void dividirInterno(Interno* in, int i, Clave& separador, Nodo*& derecho) {
+        // Las CLAVES + 1 claves y CLAVES + 2 hijos, con el nuevo en su lugar
+        Clave claves[CLAVES + 1];
+        Nodo* hijos[CLAVES + 2];
+        for (int j = 0, k = 0; j <= CLAVES; j++)
+            claves[j] = j == i ? separador : std::move(in->claves[k++]);
+        for (int j = 0, k = 0; j <= CLAVES + 1; j++)
+            hijos[j] = j == i + 1 ? derecho : in->hijos[k++];
+
+        int medio = CLAVES / 2;
+        Interno* nuevo = crearInterno();
+        in->cuenta = medio;
+        for (int j = 0; j < medio; j++) in->claves[j] = std::move(claves[j]);
+        for (int j = 0; j <= medio; j++) in->hijos[j] = hijos[j];
+        nuevo->cuenta = CLAVES - medio;
+        for (int j = 0; j < nuevo->cuenta; j++) nuevo->claves[j] = std::move(claves[medio + 1 + j]);
+        for (int j = 0; j <= nuevo->cuenta; j++) nuevo->hijos[j] = hijos[medio + 1 + j];
+
+        separador = std::move(claves[medio]);
+        derecho = nuevo;
+    }
+
+    // Hoja con menos de MINIMO claves: pide una a un hermano o se fusiona
+    // con él. Devuelve true si el padre perdió un separador
+    bool rebalancearHoja(Hoja* h, Interno* padre, int i) {
+        Hoja* izq = i > 0 ? static_cast<Hoja*>(padre->hijos[i - 1]) : nullptr;
+        Hoja* der = i < padre->cuenta ? static_cast<Hoja*>(padre->hijos[i + 1]) : nullptr;
+
+        if (izq != nullptr && izq->cuenta > MINIMO) { // la última del izquierdo
+            int u = izq->cuenta - 1;
+            insertarEnHoja(h, 0, izq->claves[u], izq->infos[u]);
+            quitarDeHoja(izq, u);
+            padre->claves[i - 1] = h->claves[0];
+            return false;
+        }
+        if (der != nullptr && der->cuenta > MINIMO) { // la primera del derecho
+            insertarEnHoja(h, h->cuenta, der->claves[0], der->infos[0]);
+            quitarDeHoja(der, 0);
+            padre->claves[i] = der->claves[0];
+            return false;
+        }
+
+        // Fusión: la hoja de la derecha se vacía en la de la izquierda
+        if (izq == nullptr) {
+            izq = h;
+            h = der;
+            i++;
+        }
+        for (int j = 0; j < h->cuenta; j++) {
+            izq->claves[izq->cuenta + j] = std::move(h->claves[j]);
+            izq->infos[izq->cuenta + j] = std::move(h->infos[j]);
+        }
+        izq->cuenta += h->cuenta;
+        izq->sig = h->sig;
+        if (h->sig != nullptr) h->sig->ant = izq;
+        quitarDeInterno(padre, i - 1);
+        borrarHoja(h);
+        return true;
+    }
+
+    // Lo mismo para un interno: las claves pasan a través del separador del padre
+    bool rebalancearInterno(Interno* x, Interno* padre, int i) {
+        Interno* izq = i > 0 ? static_cast<Interno*>(padre->hijos[i - 1]) : nullptr;
+        Interno* der = i < padre->cuenta ? static_cast<Interno*>(padre->hijos[i + 1]) : nullptr;
+
+        if (izq != nullptr && izq->cuenta > MINIMO) { // rotación a la derecha
+            for (int j = x->cuenta; j > 0; j--) {
+                x->claves[j] = std::move(x->claves[j - 1]);
+                x->hijos[j + 1] = x->hijos[j];
+            }
+            x->hijos[1] = x->hijos[0];
+            x->claves[0] = std::move(padre->claves[i - 1]);
+            x->hijos[0] = izq->hijos[izq->cuenta];
+            x->cuenta++;
+            padre->claves[i - 1] = std::move(izq->claves[izq->cuenta - 1]);
+            izq->cuenta--;
+            return false;
+        }
+        if (der != nullptr && der->cuenta > MINIMO) { // rotación a la izquierda
+            x->claves[x->cuenta] = std::move(padre->claves[i]);
+            x->hijos[x->cuenta + 1] = der->hijos[0];
+            x->cuenta++;
+            padre->claves[i] = std::move(der->claves[0]);
+            for (int j = 0; j + 1 < der->cuenta; j++) {
+                der->claves[j] = std::move(der->claves[j + 1]);
+                der->hijos[j] = der->hijos[j + 1];
+            }
+            der->hijos[der->cuenta - 1] = der->hijos[der->cuenta];
+            der->cuenta--;
+            return false;
+        }
+
+        // Fusión: izquierdo + separador del padre + derecho
+        if (izq == nullptr) {
+            izq = x;
+            x = der;
+            i++;
+        }
+        izq->claves[izq->cuenta] = std::move(padre->claves[i - 1]);
+        for (int j = 0; j < x->cuenta; j++)
+            izq->claves[izq->cuenta + 1 + j] = std::move(x->claves[j]);
+        for (int j = 0; j <= x->cuenta; j++)
+            izq->hijos[izq->cuenta + 1 + j] = x->hijos[j];
+        izq->cuenta += x->cuenta + 1;
+        quitarDeInterno(padre, i - 1);
+        borrarInterno(x);
+        return true;
+    }
+
+    void destruir(Nodo* n, int nivel) {
+        if (nivel == altura - 1) {
+            borrarHoja(static_cast<Hoja*>(n));
+            return;
+        }
+        Interno* in = static_cast<Interno*>(n);
+        for (int j = 0; j <= in->cuenta; j++)
+            destruir(in->hijos[j], nivel + 1);
+        borrarInterno(in);
+    }
+
+    // Recorridos de la estructura: visitan las claves de cada nodo (los
+    // separadores de los internos y las claves de las hojas)
+    void preordenRec(Nodo* n, int nivel, queue<Clave>& resultado) const {
+        for (int j = 0; j < n->cuenta; j++)
+            resultado.push(n->claves[j]);
+        if (nivel == altura - 1) return;
+        Interno* in = static_cast<Interno*>(n);
+        for (int j = 0; j <= in->cuenta; j++)
+            preordenRec(in->hijos[j], nivel + 1, resultado);
+    }
+
+    void posordenRec(Nodo* n, int nivel, queue<Clave>& resultado) const {
+        if (nivel < altura - 1) {
+            Interno* in = static_cast<Interno*>(n);
+            for (int j = 0; j <= in->cuenta; j++)
+                posordenRec(in->hijos[j], nivel + 1, resultado);
+        }
+        for (int j = 0; j < n->cuenta; j++)
+            resultado.push(n->claves[j]);
+    }
+
+public:
+    static_assert(CLAVES >= 4, "Un nodo del árbol B+ necesita al menos 4 claves");
+
+    // Constructor: el árbol vacío es una hoja sin claves
+    explicit ArbolBMas(const Comparar& comparar = Comparar()) : altura(1), tam(0), comp(comparar) {
+        raiz = crearHoja();
+    }
+
+    // Destructor
+    ~ArbolBMas() {
+        destruir(raiz, 0);
+    }
+
+    // Elimina todas las claves
+    void vaciar() {
+        destruir(raiz, 0);
+        altura = 1;
+        tam = 0;
+        raiz = crearHoja();
+    }
+
+    // Inserta la clave; si ya está, reemplaza su información
+    void insertar(const Clave& clave, const Valor& info) {
+        Interno* camino[MAX_ALTURA];
+        int indices[MAX_ALTURA];
+        Hoja* h = bajar(clave, camino, indices);
+        int pos = menores(h, clave);
+        if (pos < h->cuenta && !comp(clave, h->claves[pos])) {
+            h->infos[pos] = info;
+            return;
+        }
+        tam++;
+        if (h->cuenta < CLAVES) {
+            insertarEnHoja(h, pos, clave, info);
+            return;
+        }
+
+        // Hoja llena: se divide y el primer elemento de la nueva sube como
+        // separador; cada interno lleno en el camino se divide igual
+        Nodo* derecho = dividirHoja(h, pos, clave, info);
+        Clave separador = derecho->claves[0];
+        for (int nivel = altura - 2; nivel >= 0; nivel--) {
+            Interno* in = camino[nivel];
+            if (in->cuenta < CLAVES) {
+                insertarEnInterno(in, indices[nivel], separador, derecho);
+                return;
+            }
+            dividirInterno(in, indices[nivel], separador, derecho);
+        }
+
+        // Se dividió la raíz: el árbol crece un nivel
+        Interno* nueva = crearInterno();
+        nueva->claves[0] = separador;
+        nueva->hijos[0] = raiz;
+        nueva->hijos[1] = derecho;
+        nueva->cuenta = 1;
+        raiz = nueva;
+        altura++;
+    }
+
+    // Eliminación a través de la clave
+    bool eliminar(const Clave& clave) {
+        Interno* camino[MAX_ALTURA];
+        int indices[MAX_ALTURA];
+        Hoja* h = bajar(clave, camino, indices);
+        int pos = menores(h, clave);
+        if (pos == h->cuenta || comp(clave, h->claves[pos]))
+            return false;
+        quitarDeHoja(h, pos);
+        tam--;
+
+        // Los separadores iguales a la clave borrada pueden quedarse: siguen
+        // separando bien a los dos hijos
+        if (altura == 1 || h->cuenta >= MINIMO)
+            return true;
+
+        int nivel = altura - 2;
+        bool seguir = rebalancearHoja(h, camino[nivel], indices[nivel]);
+        for (; seguir && nivel > 0; nivel--) {
+            Interno* x = camino[nivel];
+            if (x->cuenta >= MINIMO) break;
+            seguir = rebalancearInterno(x, camino[nivel - 1], indices[nivel - 1]);
+        }
+
+        // La raíz interna se quedó sin separadores: su único hijo es la raíz
+        if (altura > 1 && raiz->cuenta == 0) {
+            Interno* vieja = static_cast<Interno*>(raiz);
+            raiz = vieja->hijos[0];
+            borrarInterno(vieja);
+            altura--;
+        }
+        return true;
+    }
+
+    // Buscar la clave: apunta a su información, o nullptr si no está. El
+    // puntero vale hasta la siguiente inserción o eliminación (las hojas
+    // se dividen y se fusionan)
+    const Valor* buscar(const Clave& clave) const {
+        return ubicar(clave);
+    }
+
+    bool modificar(const Clave& clave, const Valor& nuevaInfo) {
+        Hoja* h = bajar(clave, nullptr, nullptr);
+        int pos = menores(h, clave);
+        if (pos < h->cuenta && !comp(clave, h->claves[pos])) {
+            h->infos[pos] = nuevaInfo;
+            return true;
+        }
+        return false;
+    }
+
+    // Cantidad de claves en el árbol
+    size_t getTam() const {
+        return tam;
+    }
+
+    // Niveles del árbol (1 si todo cabe en una hoja)
+    int getAltura() const {
+        return altura;
+    }
+
+    // Visita en orden cada (clave, información), de hoja en hoja
+    template <class F>
+    void recorrerInorden(F visitar) const {
+        for (Hoja* h = primeraHoja(); h != nullptr; h = h->sig)
+            for (int j = 0; j < h->cuenta; j++)
+                visitar(h->claves[j], h->infos[j]);
+    }
+
+    // Visita en orden las claves en [a, b]: baja una vez hasta la hoja de a y
+    // sigue los enlaces entre hojas, O(log n + k)
+    template <class F>
+    void recorrerRango(const Clave& a, const Clave& b, F visitar) const {
+        Hoja* h = bajar(a, nullptr, nullptr);
+        int j = menores(h, a);
+        for (; h != nullptr; h = h->sig, j = 0) {
+            for (; j < h->cuenta; j++) {
+                if (comp(b, h->claves[j])) return;
+                visitar(h->claves[j], h->infos[j]);
+            }
+        }
+    }
+
+    // Recorridos (cada uno devuelve una queue<Clave>)
+
+    // Las claves guardadas en orden, siguiendo las hojas enlazadas
+    queue<Clave> inorden() {
+        queue<Clave> resultado;
+        for (Hoja* h = primeraHoja(); h != nullptr; h = h->sig)
+            for (int j = 0; j < h->cuenta; j++)
+                resultado.push(h->claves[j]);
+        return resultado;
+    }
+
+    // Las claves de cada nodo antes que las de sus hijos
+    queue<Clave> preorden() {
+        queue<Clave> resultado;
+        preordenRec(raiz, 0, resultado);
+        return resultado;
+    }
+
+    // Las claves de cada nodo después de las de sus hijos
+    queue<Clave> posorden() {
+        queue<Clave> resultado;
+        posordenRec(raiz, 0, resultado);
+        return resultado;
+    }
+
+    // Las claves nivel por nivel, de izquierda a derecha (las hojas al final)
+    queue<Clave> porNiveles() {
+        queue<Clave> resultado;
+        vector<Nodo*> nivelActual(1, raiz);
+        for (int nivel = 0; nivel < altura; nivel++) {
+            vector<Nodo*> siguiente;
+            for (size_t i = 0; i < nivelActual.size(); i++) {
+                Nodo* n = nivelActual[i];
+                for (int j = 0; j < n->cuenta; j++)
+                    resultado.push(n->claves[j]);
+                if (nivel < altura - 1) {
+                    Interno* in = static_cast<Interno*>(n);
+                    for (int j = 0; j <= in->cuenta; j++)
+                        siguiente.push_back(in->hijos[j]);
+                }
+            }
+            nivelActual.swap(siguiente);
+        }
+        return resultado;
+    }
+
+private:
+    ArbolBMas(const ArbolBMas&);            // no copiable
+    ArbolBMas& operator=(const ArbolBMas&);
+};
+
+#endif
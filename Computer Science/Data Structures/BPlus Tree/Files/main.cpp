@@ -0,0 +1,170 @@
+#include <iostream>
+#include "ArbolBMas.h"
+#include "../../Tools/Files/lote.h"
+
+using namespace std;
+
+// Nodos de 4 claves para que la demostración muestre divisiones y fusiones
+// con pocas claves (el tamaño normal con int es de 64)
+typedef ArbolBMas<int, string, less<int>, 4> ArbolDemo;
+
+// Imprime una cola de claves
+void mostrarCola(queue<int> cola, string nombre) {
+    cout << nombre << ": ";
+    while (!cola.empty()) {
+        cout << cola.front() << " ";
+        cola.pop();
+    }
+    cout << endl;
+}
+
+// Texto de una búsqueda: la información, o un aviso si la clave no está
+string textoBusqueda(const string* info) {
+    return info != nullptr ? *info : "(no existe)";
+}
+
+// Modo por lotes: --lote <archivo|-> (el argumento de cada operación es la clave)
+int modoLote(int argc, char* argv[]) {
+    vector<Operacion> ops;
+    try {
+        if (!cargarOperaciones(valorOpcion(argc, argv, "--lote"), ops)) return 1;
+    } catch (invalid_argument& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    ArbolBMas<int, string> arbol;
+    ResultadoLote r = ejecutarLote(ops, [&](const Operacion& op) -> bool {
+        int clave = (int)op.arg;
+        switch (op.tipo) {
+            case OP_INSERTAR:
+                arbol.insertar(clave, op.valor);
+                return true;
+            case OP_MODIFICAR:
+                return arbol.modificar(clave, op.valor);
+            case OP_ELIMINAR:
+                return arbol.eliminar(clave);
+            default: {
+                const string* info = arbol.buscar(clave);
+                noOptimizar(info);
+                return info != nullptr;
+            }
+        }
+    });
+    cout << "ArbolBMas: " << ops.size() << " operaciones, "
+         << arbol.getTam() << " claves al final, altura " << arbol.getAltura() << "\n";
+    imprimirReporte(cout, r);
+    return 0;
+}
+
+// Llamada al programa principal
+int main(int argc, char* argv[]) {
+    // Modos no interactivos
+    if (tieneOpcion(argc, argv, "--generar")) return generarCargaCLI(argc, argv);
+    if (valorOpcion(argc, argv, "--lote")) return modoLote(argc, argv);
+
+    ArbolDemo arbol;
+
+    cout << "===============================================" << endl;
+    cout << "          PROGRAMA DE ARBOL B+" << endl;
+    cout << "===============================================\n" << endl;
+
+    // ========================================
+    // FASE 1: Inserción con divisiones
+    // ========================================
+    cout << "1. INSERCION DE CLAVES (nodos de 4 claves)" << endl;
+    cout << "-------------------------------------------" << endl;
+
+    int claves[] = { 10, 5, 15, 3, 7, 6, 12, 18, 1, 8, 11, 13, 20 };
+    for (size_t i = 0; i < sizeof(claves) / sizeof(claves[0]); i++) {
+        int alturaAntes = arbol.getAltura();
+        arbol.insertar(claves[i], "Clave " + to_string(claves[i]));
+        cout << "Insertado: " << claves[i];
+        if (arbol.getAltura() > alturaAntes)
+            cout << " --> se dividio la raiz, altura " << arbol.getAltura();
+        cout << endl;
+    }
+
+    // ========================================
+    // FASE 2: Recorridos de la estructura
+    // ========================================
+    cout << "\n2. PRIMEROS DOS RECORRIDOS" << endl;
+    cout << "-------------------------------------------" << endl;
+    mostrarCola(arbol.inorden(), "INORDEN  ");
+    mostrarCola(arbol.preorden(), "PREORDEN ");
+
+    // ========================================
+    // FASE 3: Buscar clave dada por usuario
+    // ========================================
+    cout << "\n3. BUSQUEDA DE CLAVE" << endl;
+    cout << "-------------------------------------------" << endl;
+
+    int claveBuscar;
+    cout << "Ingrese una clave a buscar: ";
+    cin >> claveBuscar;
+
+    const string* info = arbol.buscar(claveBuscar);
+    if (info != nullptr) {
+        cout << "\n[ENCONTRADO] Clave " << claveBuscar << endl;
+        cout << "Informacion: " << *info << endl;
+    } else {
+        cout << "\n[NO ENCONTRADO] La clave " << claveBuscar
+             << " no existe en el arbol." << endl;
+    }
+
+    // ========================================
+    // FASE 4: Eliminación con préstamos y fusiones
+    // ========================================
+    cout << "\n4. ELIMINACION DE CLAVES" << endl;
+    cout << "-------------------------------------------" << endl;
+
+    int borrar[] = { 20, 1, 5, 15, 3, 6 };
+    for (size_t i = 0; i < sizeof(borrar) / sizeof(borrar[0]); i++) {
+        int alturaAntes = arbol.getAltura();
+        if (arbol.eliminar(borrar[i])) {
+            cout << "[OK] Clave " << borrar[i] << " eliminada";
+            if (arbol.getAltura() < alturaAntes)
+                cout << " --> se fusiono bajo la raiz, altura " << arbol.getAltura();
+            cout << endl;
+            mostrarCola(arbol.porNiveles(), "Por niveles");
+        }
+    }
+
+    // ========================================
+    // FASE 5: Mostrar otros dos recorridos
+    // ========================================
+    cout << "\n5. RECORRIDOS RESTANTES" << endl;
+    cout << "-------------------------------------------" << endl;
+    mostrarCola(arbol.posorden(), "POSORDEN  ");
+    mostrarCola(arbol.porNiveles(), "POR NIVELES");
+
+    // ========================================
+    // DEMOSTRACIÓN ADICIONAL
+    // ========================================
+    cout << "\n6. FUNCIONALIDADES ADICIONALES" << endl;
+    cout << "-------------------------------------------" << endl;
+
+    cout << "\nModificando informacion de clave 10..." << endl;
+    if (arbol.modificar(10, "Clave 10 modificada")) {
+        cout << "[OK] Modificacion exitosa." << endl;
+        cout << "Nueva info: " << textoBusqueda(arbol.buscar(10)) << endl;
+    }
+
+    // Consulta por rango sobre las hojas enlazadas
+    cout << "\nRango [7, 12]:" << endl;
+    arbol.recorrerRango(7, 12, [](const int& clave, const string& info) {
+        cout << "  " << clave << " -> " << info << endl;
+    });
+
+    // Estado final
+    cout << "\n===============================================" << endl;
+    cout << "           ESTADO FINAL DEL ARBOL" << endl;
+    cout << "===============================================" << endl;
+    cout << arbol.getTam() << " claves, altura " << arbol.getAltura() << endl;
+    mostrarCola(arbol.inorden(), "INORDEN FINAL");
+
+    cout << "\n¡Programa ejecutado exitosamente!" << endl;
+    cout << "===============================================\n" << endl;
+
+    return 0;
+}
@@ -13,6 +13,17 @@
 #include <cstdlib>
 #include <stdexcept>
 
+// Instrumentación opcional (compilar con -DLISTAS_INSTRUMENTADAS); si no
+// se activa, las macros quedan vacías y no agregan ningún costo
+#ifdef LISTAS_INSTRUMENTADAS
+#include "../../Tools/Files/instrumentacion.h"
+#else
+#define LISTA_REGISTRAR_RECORRIDO(op, nodos)
+#define LISTA_REGISTRAR_RESERVA(bytes)
+#define LISTA_REGISTRAR_LIBERACION(bytes)
+#define LISTA_MEDIR_ARCHIVO(op)
+#endif
+
 using namespace std;
 
 // -----------------------------------------------------
@@ -40,6 +51,8 @@ public:
     ListaDoble() {
         cab = new NodoDoble<T>;
         cen = new NodoDoble<T>;
+        LISTA_REGISTRAR_RESERVA(sizeof(NodoDoble<T>)); // cabecera
+        LISTA_REGISTRAR_RESERVA(sizeof(NodoDoble<T>)); // centinela
         
         // Configuración: cabecera y centinela se apuntan a sí mismos en sus extremos
         cab->sig = cen;
@@ -58,9 +71,12 @@ public:
             NodoDoble<T>* temp = actual;
             actual = actual->sig;
             delete temp;
+            LISTA_REGISTRAR_LIBERACION(sizeof(NodoDoble<T>));
         }
         delete cab;
         delete cen;
+        LISTA_REGISTRAR_LIBERACION(sizeof(NodoDoble<T>)); // cabecera
+        LISTA_REGISTRAR_LIBERACION(sizeof(NodoDoble<T>)); // centinela
     }
 
     // Métodos públicos
@@ -93,6 +109,7 @@ template <class T>
 void ListaDoble<T>::insertar_inicio(T infoNueva) {
 	// Colocamos la info en el nodo nuevo
     NodoDoble<T>* nuevo = new NodoDoble<T>; //aux
+    LISTA_REGISTRAR_RESERVA(sizeof(NodoDoble<T>));
     nuevo->info = infoNueva;
     
     // Insertar entre cabecera y el primer nodo real
@@ -108,9 +125,11 @@ template <class T>
 void ListaDoble<T>::insertar_final(T infoNueva) {
 	// Colocamos la info en el nodo nuevo
     NodoDoble<T>* nuevo = new NodoDoble<T>; //aux
+    LISTA_REGISTRAR_RESERVA(sizeof(NodoDoble<T>));
     nuevo->info = infoNueva;
     
-    // Insertar entre el último nodo real y el centinela
+    // Insertar entre el último nodo real y el centinela (sin recorrer)
+    LISTA_REGISTRAR_RECORRIDO(LISTA_INSERTAR_FINAL, 0);
     nuevo->sig = cen;           // nuevo apunta al centinela
     nuevo->ant = cen->ant;      // nuevo apunta hacia atrás al último nodo
     cen->ant->sig = nuevo;      // el último nodo apunta a nuevo
@@ -133,10 +152,12 @@ void ListaDoble<T>::insertar_pos(T infoNueva, int pos) {
     }
     // Colocamos la info en el nodo nuevo
     NodoDoble<T>* nuevo = new NodoDoble<T>;
+    LISTA_REGISTRAR_RESERVA(sizeof(NodoDoble<T>));
     nuevo->info = infoNueva;
     
     //Buscamos la posición con un nodo aux = actual
     NodoDoble<T>* actual = cab->sig; 
+    LISTA_REGISTRAR_RECORRIDO(LISTA_INSERTAR_POS, pos);
     for (int i = 0; i < pos; i++) {
         actual = actual->sig;
     }
@@ -156,6 +177,7 @@ T ListaDoble<T>::obtenerDato(int pos) {
     
     // creamos nodo auxiliar para buscar la info de acuerdo a la posición
     NodoDoble<T>* actual = cab->sig;
+    LISTA_REGISTRAR_RECORRIDO(LISTA_OBTENER, pos);
     for (int i = 0; i < pos; i++) {
         actual = actual->sig;
     }
@@ -168,6 +190,7 @@ bool ListaDoble<T>::modificar(int pos, T infoNueva) {
     if (pos < 0 || pos >= tam) throw out_of_range("Posición inválida"); // validar posición
     
     NodoDoble<T>* actual = cab->sig; //aux
+    LISTA_REGISTRAR_RECORRIDO(LISTA_MODIFICAR, pos);
     for (int i = 0; i < pos; i++) {
         actual = actual->sig; //ubicarnos en el nodo
     }
@@ -181,6 +204,7 @@ bool ListaDoble<T>::eliminar(int pos) {
     if (pos < 0 || pos >= tam) throw out_of_range("Posición inválida"); // validar posición
     
     NodoDoble<T>* actual = cab->sig; //aux
+    LISTA_REGISTRAR_RECORRIDO(LISTA_ELIMINAR, pos);
     for (int i = 0; i < pos; i++) {
         actual = actual->sig; //buscamos la posición
     }
@@ -190,6 +214,7 @@ bool ListaDoble<T>::eliminar(int pos) {
     actual->sig->ant = actual->ant;
     
     delete actual; // eliminamos el nodo de la info
+    LISTA_REGISTRAR_LIBERACION(sizeof(NodoDoble<T>));
     tam--; // decrementamos el tamaño
     return true; // True si se elimina
 }
@@ -202,6 +227,7 @@ void ListaDoble<T>::vaciar_lista() {
         NodoDoble<T>* temp = actual; // aux2 = aux1
         actual = actual->sig; // actual (aux1) avanza
         delete temp; // se elimina actual (debido al temp = actual) 
+        LISTA_REGISTRAR_LIBERACION(sizeof(NodoDoble<T>));
     }
     // Restablecer la lista vacía
     cab->sig = cen; //cab apunta a centinela
@@ -8,26 +8,10 @@
 #include <sstream>
 #include <string>
 #include "lista_doble.h"
+#include "persona.h"
+#include "../../Tools/Files/lote.h"
 using namespace std;
 
-// -----------------------------------------------------
-// Estructura para almacenar datos de Persona
-// -----------------------------------------------------
-struct Persona {
-    string cedula;
-    string nombre;
-    string codigoEstudiante;
-    string carrera;
-    int edad;
-    
-    // Constructor por defecto
-    Persona() : cedula(""), nombre(""), codigoEstudiante(""), carrera(""), edad(0) {}
-    
-    // Constructor con parámetros
-    Persona(string ced, string nom, string cod, string car, int ed) 
-        : cedula(ced), nombre(nom), codigoEstudiante(cod), carrera(car), edad(ed) {}
-};
-
 // Función para imprimir una persona
 void imprimirPersona(const Persona& p) {
     cout << "Cédula: " << p.cedula << " | Nombre: " << p.nombre 
@@ -37,6 +21,7 @@ void imprimirPersona(const Persona& p) {
 
 // Función para cargar datos desde archivo
 void cargar_desde_archivo(ListaDoble<Persona>& lista, const string& nombreArchivo) {
+    LISTA_MEDIR_ARCHIVO(ARCHIVO_CARGA);
     ifstream archivo(nombreArchivo.c_str());
     if (!archivo.is_open()) {
         cout << "No se pudo abrir el archivo: " << nombreArchivo << endl;
@@ -51,19 +36,7 @@ void cargar_desde_archivo(ListaDoble<Persona>& lista, const string& nombreArchiv
     getline(archivo, linea);
     
     while (getline(archivo, linea)) {
-        stringstream ss(linea);
-        string cedula, nombre, codigo, carrera;
-        int edad;
-        
-        // Formato esperado: cedula,nombre,codigo,carrera,edad
-        getline(ss, cedula, ',');
-        getline(ss, nombre, ',');
-        getline(ss, codigo, ',');
-        getline(ss, carrera, ',');
-        ss >> edad;
-        
-        Persona p(cedula, nombre, codigo, carrera, edad);
-        lista.insertar_final(p);
+        lista.insertar_final(persona_desde_csv(linea));
     }
     
     archivo.close();
@@ -72,6 +45,7 @@ void cargar_desde_archivo(ListaDoble<Persona>& lista, const string& nombreArchiv
 
 // Función para guardar datos en archivo
 void guardar_en_archivo(ListaDoble<Persona>& lista, const string& nombreArchivo) {
+    LISTA_MEDIR_ARCHIVO(ARCHIVO_GUARDADO);
     ofstream archivo(nombreArchivo.c_str());
     if (!archivo.is_open()) {
         cout << "No se pudo crear el archivo: " << nombreArchivo << endl;
@@ -135,7 +109,59 @@ void eliminar_por_cedula(ListaDoble<Persona>& lista, const string& cedula) {
     cout << "No se encontró ninguna persona con cédula: " << cedula << endl;
 }
 
-int main() {
+// -----------------------------------------------------
+// Modo por lotes: --lote <archivo|->
+// El valor de insertar/modificar es una línea CSV de Persona; si no trae
+// comas (cargas generadas) se usa como cédula y código de una persona
+// sintética. Las posiciones se reducen al rango válido de la lista.
+// -----------------------------------------------------
+Persona persona_de_lote(const string& valor) {
+    if (valor.find(',') != string::npos) return persona_desde_csv(valor);
+    return Persona(valor, "Persona " + valor, valor, "Sin carrera", 18);
+}
+
+int modoLote(int argc, char* argv[]) {
+    vector<Operacion> ops;
+    try {
+        if (!cargarOperaciones(valorOpcion(argc, argv, "--lote"), ops)) return 1;
+    } catch (invalid_argument& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    ListaDoble<Persona> lista;
+    ResultadoLote r = ejecutarLote(ops, [&](const Operacion& op) -> bool {
+        int tam = lista.getTam();
+        if (op.tipo == OP_INSERTAR) {
+            lista.insertar_pos(persona_de_lote(op.valor), posicionEnRango(op.arg, tam + 1));
+            return true;
+        }
+        if (tam == 0) return false; // nada que modificar, eliminar o buscar
+        int pos = posicionEnRango(op.arg, tam);
+        switch (op.tipo) {
+            case OP_MODIFICAR: return lista.modificar(pos, persona_de_lote(op.valor));
+            case OP_ELIMINAR:  return lista.eliminar(pos);
+            default: {
+                Persona p = lista.obtenerDato(pos);
+                noOptimizar(p);
+                return true;
+            }
+        }
+    });
+    cout << "ListaDoble<Persona>: " << ops.size() << " operaciones, "
+         << lista.getTam() << " personas al final\n";
+    imprimirReporte(cout, r);
+#ifdef LISTAS_INSTRUMENTADAS
+    volcarEstadisticasJSON(cerr);
+#endif
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Modos no interactivos
+    if (tieneOpcion(argc, argv, "--generar")) return generarCargaCLI(argc, argv);
+    if (valorOpcion(argc, argv, "--lote")) return modoLote(argc, argv);
+
     // Creamos la lista de personas
     ListaDoble<Persona> listaPersonas;
     
@@ -350,5 +376,8 @@ int main() {
 
     } while (opcion != 0);
 
+#ifdef LISTAS_INSTRUMENTADAS
+    volcarEstadisticasJSON(cerr); // contadores de la sesión
+#endif
     return 0;
 }
@@ -0,0 +1,49 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez 
+//
+// Registro de Persona compartido por el programa de la lista doble y los
+// programas de medición.
+
+#ifndef PERSONA_H
+#define PERSONA_H
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// -----------------------------------------------------
+// Estructura para almacenar datos de Persona
+// -----------------------------------------------------
+struct Persona {
+    string cedula;
+    string nombre;
+    string codigoEstudiante;
+    string carrera;
+    int edad;
+    
+    // Constructor por defecto
+    Persona() : cedula(""), nombre(""), codigoEstudiante(""), carrera(""), edad(0) {}
+    
+    // Constructor con parámetros
+    Persona(string ced, string nom, string cod, string car, int ed) 
+        : cedula(ced), nombre(nom), codigoEstudiante(cod), carrera(car), edad(ed) {}
+};
+
+// Función para convertir una línea CSV en Persona
+inline Persona persona_desde_csv(const string& linea) {
+    stringstream ss(linea);
+    string cedula, nombre, codigo, carrera;
+    int edad = 0;
+    
+    // Formato esperado: cedula,nombre,codigo,carrera,edad
+    getline(ss, cedula, ',');
+    getline(ss, nombre, ',');
+    getline(ss, codigo, ',');
+    getline(ss, carrera, ',');
+    ss >> edad;
+    
+    return Persona(cedula, nombre, codigo, carrera, edad);
+}
+
+#endif
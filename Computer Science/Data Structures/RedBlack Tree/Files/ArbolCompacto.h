@@ -0,0 +1,450 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Variante compacta del Árbol RojiNegro: los nodos viven en un arreglo
+contiguo y se enlazan por índices de 32 bits en lugar de punteros.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+// Mismos algoritmos de Cormen que ArbolRojiNegro.h, con otra disposición:
+//
+// - Parte "caliente" (lo que se lee al descender): clave, izq, der y padre.
+//   El color va en el bit más alto del campo del padre, así que un nodo con
+//   clave int ocupa 16 bytes: cuatro por línea de caché.
+// - Parte "fría": la información (Valor) va en un arreglo paralelo, y solo
+//   se toca cuando la búsqueda termina.
+// - El índice 0 es el centinela NIL. Los nodos eliminados se encadenan por
+//   izq en una lista de libres y se reutilizan.
+// - destruirArbol es reiniciar el arreglo: no hay un delete por nodo.
+//
+// Admite hasta 2^31 - 1 nodos.
+
+#ifndef ARBOLCOMPACTO_H
+#define ARBOLCOMPACTO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+template <class Clave>
+struct NodoCompacto {
+    Clave clave;
+    uint32_t izq, der;
+    uint32_t padreColor; // bit 31 = color (1 = ROJO), bits 0..30 = padre
+};
+
+template <class Clave = int, class Valor = string, class Comparar = less<Clave> >
+class ArbolRojiNegroCompacto {
+private:
+    static const uint32_t NIL = 0;          // centinela (índice 0)
+    static const uint32_t BIT_ROJO = 0x80000000u;
+    static const uint32_t MAX_NODOS = 0x7FFFFFFFu;
+
+    vector<NodoCompacto<Clave> > nodos;     // parte caliente
+    vector<Valor> infos;                    // parte fría, mismo índice
+    uint32_t raiz;
+    uint32_t libres;                        // lista de nodos libres (por izq)
+    size_t cantidad;
+    Comparar comp;
+
+    // Acceso a los campos empaquetados
+    uint32_t& izq(uint32_t n) { return nodos[n].izq; }
+    uint32_t& der(uint32_t n) { return nodos[n].der; }
+    uint32_t padre(uint32_t n) const { return nodos[n].padreColor & ~BIT_ROJO; }
+    void ponerPadre(uint32_t n, uint32_t p) { nodos[n].padreColor = (nodos[n].padreColor & BIT_ROJO) | p; }
+    bool esRojo(uint32_t n) const { return (nodos[n].padreColor & BIT_ROJO) != 0; }
+    void ponerRojo(uint32_t n) { nodos[n].padreColor |= BIT_ROJO; }
+    void ponerNegro(uint32_t n) { nodos[n].padreColor &= ~BIT_ROJO; }
+    void copiarColor(uint32_t destino, uint32_t origen) {
+        if (esRojo(origen)) ponerRojo(destino);
+        else ponerNegro(destino);
+    }
+
+    uint32_t nuevoNodo(const Clave& clave, const Valor& info) {
+        uint32_t n;
+        if (libres != NIL) {
+            n = libres;
+            libres = nodos[n].izq;
+            infos[n] = info;
+        } else {
+            if (nodos.size() > MAX_NODOS) throw length_error("ArbolRojiNegroCompacto lleno");
+            n = (uint32_t)nodos.size();
+            nodos.push_back(NodoCompacto<Clave>());
+            infos.push_back(info);
+        }
+        nodos[n].clave = clave;
+        nodos[n].izq = nodos[n].der = NIL;
+        nodos[n].padreColor = BIT_ROJO; // nuevo nodo rojo
+        return n;
+    }
+
+    void liberarNodo(uint32_t n) {
+        infos[n] = Valor();   // suelta lo que tuviera reservado la información
+        nodos[n].izq = libres;
+        libres = n;
+    }
+
+    template <class K>
+    uint32_t buscarNodo(const K& clave) const {
+        uint32_t actual = raiz;
+        while (actual != NIL) {
+            const NodoCompacto<Clave>& n = nodos[actual];
+            if (comp(clave, n.clave))
+                actual = n.izq;
+            else if (comp(n.clave, clave))
+                actual = n.der;
+            else
+                break;
+        }
+        return actual;
+    }
+
+    uint32_t minimo(uint32_t n) {
+        while (izq(n) != NIL)
+            n = izq(n);
+        return n;
+    }
+
+    // Algoritmos de Rotación izq - der
+    void rotarIzquierda(uint32_t x) {
+        uint32_t y = der(x);
+        der(x) = izq(y);
+        if (izq(y) != NIL)
+            ponerPadre(izq(y), x);
+        ponerPadre(y, padre(x));
+        if (padre(x) == NIL)
+            raiz = y;
+        else if (x == izq(padre(x)))
+            izq(padre(x)) = y;
+        else
+            der(padre(x)) = y;
+        izq(y) = x;
+        ponerPadre(x, y);
+    }
+
+    void rotarDerecha(uint32_t x) {
+        uint32_t y = izq(x);
+        izq(x) = der(y);
+        if (der(y) != NIL)
+            ponerPadre(der(y), x);
+        ponerPadre(y, padre(x));
+        if (padre(x) == NIL)
+            raiz = y;
+        else if (x == der(padre(x)))
+            der(padre(x)) = y;
+        else
+            izq(padre(x)) = y;
+        der(y) = x;
+        ponerPadre(x, y);
+    }
+
+    void ajustarInsercion(uint32_t z) {
+        while (esRojo(padre(z))) {
+            uint32_t p = padre(z);
+            uint32_t a = padre(p);
+            if (p == izq(a)) {
+                uint32_t y = der(a);
+                if (esRojo(y)) {
+                    ponerNegro(p);
+                    ponerNegro(y);
+                    ponerRojo(a);
+                    z = a;
+                } else {
+                    if (z == der(p)) {
+                        z = p;
+                        rotarIzquierda(z);
+                    }
+                    ponerNegro(padre(z));
+                    ponerRojo(padre(padre(z)));
+                    rotarDerecha(padre(padre(z)));
+                }
+            } else {
+                uint32_t y = izq(a);
+                if (esRojo(y)) {
+                    ponerNegro(p);
+                    ponerNegro(y);
+                    ponerRojo(a);
+                    z = a;
+                } else {
+                    if (z == izq(p)) {
+                        z = p;
+                        rotarDerecha(z);
+                    }
+                    ponerNegro(padre(z));
+                    ponerRojo(padre(padre(z)));
+                    rotarIzquierda(padre(padre(z)));
+                }
+            }
+        }
+        ponerNegro(raiz);
+    }
+
+    void transplantar(uint32_t u, uint32_t v) {
+        if (padre(u) == NIL)
+            raiz = v;
+        else if (u == izq(padre(u)))
+            izq(padre(u)) = v;
+        else
+            der(padre(u)) = v;
+        ponerPadre(v, padre(u));
+    }
+
+    void ajustarEliminacion(uint32_t x) {
+        while (x != raiz && !esRojo(x)) {
+            if (x == izq(padre(x))) {
+                uint32_t w = der(padre(x));
+                if (esRojo(w)) {
+                    ponerNegro(w);
+                    ponerRojo(padre(x));
+                    rotarIzquierda(padre(x));
+                    w = der(padre(x));
+                }
+                if (!esRojo(izq(w)) && !esRojo(der(w))) {
+                    ponerRojo(w);
+                    x = padre(x);
+                } else {
+                    if (!esRojo(der(w))) {
+                        ponerNegro(izq(w));
+                        ponerRojo(w);
+                        rotarDerecha(w);
+                        w = der(padre(x));
+                    }
+                    copiarColor(w, padre(x));
+                    ponerNegro(padre(x));
+                    ponerNegro(der(w));
+                    rotarIzquierda(padre(x));
+                    x = raiz;
+                }
+            } else {
+                uint32_t w = izq(padre(x));
+                if (esRojo(w)) {
+                    ponerNegro(w);
+                    ponerRojo(padre(x));
+                    rotarDerecha(padre(x));
+                    w = izq(padre(x));
+                }
+                if (!esRojo(der(w)) && !esRojo(izq(w))) {
+                    ponerRojo(w);
+                    x = padre(x);
+                } else {
+                    if (!esRojo(izq(w))) {
+                        ponerNegro(der(w));
+                        ponerRojo(w);
+                        rotarIzquierda(w);
+                        w = izq(padre(x));
+                    }
+                    copiarColor(w, padre(x));
+                    ponerNegro(padre(x));
+                    ponerNegro(izq(w));
+                    rotarDerecha(padre(x));
+                    x = raiz;
+                }
+            }
+        }
+        ponerNegro(x);
+    }
+
+    // Eliminar el árbol: reinicio del arreglo (sin recorrerlo)
+    void destruirArbol() {
+        nodos.clear();
+        infos.clear();
+        nodos.push_back(NodoCompacto<Clave>()); // NIL
+        infos.push_back(Valor());
+        nodos[NIL].izq = nodos[NIL].der = NIL;
+        nodos[NIL].padreColor = NIL;            // negro
+        raiz = NIL;
+        libres = NIL;
+        cantidad = 0;
+    }
+
+public:
+    // Constructor
+    explicit ArbolRojiNegroCompacto(const Comparar& comparar = Comparar()) : comp(comparar) {
+        destruirArbol();
+    }
+
+    // Reserva espacio para n nodos (evita copiar el arreglo al crecer)
+    void reservar(size_t n) {
+        nodos.reserve(n + 1);
+        infos.reserve(n + 1);
+    }
+
+    // Vacía el árbol conservando la memoria reservada
+    void vaciar() {
+        destruirArbol();
+    }
+
+    size_t getTam() const { return cantidad; }
+
+    // Bytes ocupados por los arreglos (sin contar lo que Valor reserve aparte)
+    size_t memoriaUsada() const {
+        return nodos.capacity() * sizeof(NodoCompacto<Clave>) + infos.capacity() * sizeof(Valor);
+    }
+
+    void insertar(const Clave& clave, const Valor& info) {
+        uint32_t z = nuevoNodo(clave, info);
+
+        uint32_t y = NIL;
+        uint32_t x = raiz;
+
+        while (x != NIL) {
+            y = x;
+            if (comp(clave, nodos[x].clave))
+                x = izq(x);
+            else
+                x = der(x);
+        }
+
+        ponerPadre(z, y);
+
+        if (y == NIL)
+            raiz = z;
+        else if (comp(clave, nodos[y].clave))
+            izq(y) = z;
+        else
+            der(y) = z;
+
+        cantidad++;
+        ajustarInsercion(z);
+    }
+
+    bool eliminar(const Clave& clave) {
+        uint32_t z = buscarNodo(clave);
+        if (z == NIL)
+            return false;
+
+        uint32_t y = z;
+        uint32_t x;
+        bool colorOriginalRojo = esRojo(y);
+
+        if (izq(z) == NIL) {
+            x = der(z);
+            transplantar(z, der(z));
+        } else if (der(z) == NIL) {
+            x = izq(z);
+            transplantar(z, izq(z));
+        } else {
+            y = minimo(der(z));
+            colorOriginalRojo = esRojo(y);
+            x = der(y);
+
+            if (padre(y) == z) {
+                ponerPadre(x, y);
+            } else {
+                transplantar(y, der(y));
+                der(y) = der(z);
+                ponerPadre(der(y), y);
+            }
+
+            transplantar(z, y);
+            izq(y) = izq(z);
+            ponerPadre(izq(y), y);
+            copiarColor(y, z);
+        }
+
+        liberarNodo(z);
+        cantidad--;
+
+        if (!colorOriginalRojo)
+            ajustarEliminacion(x);
+
+        return true;
+    }
+
+    // Buscar la clave: apunta a su información, o nullptr si no está. El
+    // puntero vale hasta la siguiente inserción o eliminación (los arreglos
+    // pueden crecer o compactarse)
+    const Valor* buscar(const Clave& clave) const {
+        uint32_t n = buscarNodo(clave);
+        if (n != NIL)
+            return &infos[n];
+        return nullptr;
+    }
+
+    bool modificar(const Clave& clave, const Valor& nuevaInfo) {
+        uint32_t n = buscarNodo(clave);
+        if (n != NIL) {
+            infos[n] = nuevaInfo;
+            return true;
+        }
+        return false;
+    }
+
+    // Recorridos (misma salida que ArbolRojiNegro)
+    queue<Clave> inorden() {
+        queue<Clave> resultado;
+        vector<uint32_t> pila;
+        uint32_t actual = raiz;
+        while (actual != NIL || !pila.empty()) {
+            while (actual != NIL) {
+                pila.push_back(actual);
+                actual = izq(actual);
+            }
+            actual = pila.back();
+            pila.pop_back();
+            resultado.push(nodos[actual].clave);
+            actual = der(actual);
+        }
+        return resultado;
+    }
+
+    queue<Clave> preorden() {
+        queue<Clave> resultado;
+        if (raiz == NIL) return resultado;
+        vector<uint32_t> pila(1, raiz);
+        while (!pila.empty()) {
+            uint32_t actual = pila.back();
+            pila.pop_back();
+            resultado.push(nodos[actual].clave);
+            if (der(actual) != NIL) pila.push_back(der(actual));
+            if (izq(actual) != NIL) pila.push_back(izq(actual));
+        }
+        return resultado;
+    }
+
+    queue<Clave> posorden() {
+        queue<Clave> resultado;
+        if (raiz == NIL) return resultado;
+        vector<uint32_t> pila1(1, raiz), pila2;
+        while (!pila1.empty()) {
+            uint32_t actual = pila1.back();
+            pila1.pop_back();
+            pila2.push_back(actual);
+            if (izq(actual) != NIL) pila1.push_back(izq(actual));
+            if (der(actual) != NIL) pila1.push_back(der(actual));
+        }
+        while (!pila2.empty()) {
+            resultado.push(nodos[pila2.back()].clave);
+            pila2.pop_back();
+        }
+        return resultado;
+    }
+
+    queue<Clave> porNiveles() {
+        queue<Clave> resultado;
+        if (raiz == NIL) return resultado;
+        queue<uint32_t> cola;
+        cola.push(raiz);
+        while (!cola.empty()) {
+            uint32_t actual = cola.front();
+            cola.pop();
+            resultado.push(nodos[actual].clave);
+            if (izq(actual) != NIL) cola.push(izq(actual));
+            if (der(actual) != NIL) cola.push(der(actual));
+        }
+        return resultado;
+    }
+};
+
+#endif
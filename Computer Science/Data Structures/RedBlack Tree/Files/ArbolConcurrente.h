@@ -0,0 +1,177 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Árbol RojiNegro para muchos lectores y pocos escritores: las búsquedas no
+toman candados ni esperan a los escritores.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+// Publicación "izquierda-derecha" (Left-Right) sobre dos copias completas
+// de ArbolRojiNegro:
+//
+// - Los lectores abren una GuardiaEpoca, leen qué copia está publicada y la
+//   recorren sin escribir nada en ella. No reintentan ni esperan a los
+//   escritores; solo esperan si ya hay DominioEpocas::MAX_RANURAS (64)
+//   guardias abiertas a la vez, cediendo el procesador hasta que se
+//   suelte una.
+// - Los escritores se turnan con un mutex. Cada escritura se aplica primero
+//   a la copia que nadie lee y se publica esa copia. Luego se espera un
+//   período de gracia (DominioEpocas::sincronizar) para que salgan los
+//   lectores que aún estaban en la otra, y se repite la escritura allí.
+// - Una copia nunca cambia mientras alguien la lee, así que los nodos que
+//   elimina una escritura se liberan en el acto: el período de gracia ya
+//   hizo el trabajo de la recuperación por épocas.
+//
+// El costo es el doble de memoria y aplicar cada escritura dos veces;
+// escribir(f) agrupa varias en un solo período de gracia. Si una de las dos
+// aplicaciones lanza una excepción, la copia que no está publicada se
+// rearma desde la publicada, así que los lectores nunca pasan de una
+// versión a otra distinta.
+
+#ifndef ARBOLCONCURRENTE_H
+#define ARBOLCONCURRENTE_H
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ArbolRojiNegro.h"
+#include "../../Tools/Files/epocas.h"
+using namespace std;
+
+// Guarda lo que devuelve la primera aplicación de una escritura (nada si
+// la función es void)
+template <class R>
+struct ResultadoEscritura {
+    R valor;
+    template <class F, class A>
+    void primera(F& f, A& a) { valor = f(a); }
+    R resultado() { return valor; }
+};
+
+template <>
+struct ResultadoEscritura<void> {
+    template <class F, class A>
+    void primera(F& f, A& a) { f(a); }
+    void resultado() {}
+};
+
+template <class Clave = int, class Valor = string, class Comparar = less<Clave> >
+class ArbolConcurrente {
+public:
+    typedef ArbolRojiNegro<Clave, Valor, Comparar> Arbol;
+
+private:
+    Arbol izquierda, derecha;
+    atomic<int> publicada;           // 0 = izquierda, 1 = derecha
+    mutex escritura;                 // un escritor a la vez
+    mutable DominioEpocas dominio;   // guardias de los lectores
+    bool libreDesfasada;             // la copia no publicada quedó a medias
+
+    Arbol& copia(int i) { return i == 0 ? izquierda : derecha; }
+    const Arbol& copia(int i) const { return i == 0 ? izquierda : derecha; }
+
+    // Rearma la copia destino con las entradas de la otra, en O(n). Solo con
+    // el mutex de escritura y sin lectores en destino
+    void resincronizar(int destino) {
+        const Arbol& fuente = copia(1 - destino);
+        vector<pair<Clave, Valor> > entradas;
+        entradas.reserve(fuente.getTam());
+        for (typename Arbol::iterador it = fuente.begin(); it != fuente.end(); ++it)
+            entradas.push_back(make_pair(it.clave(), it.info()));
+        copia(destino).vaciar();
+        copia(destino).construirDesdeOrdenado(entradas.begin(), entradas.end());
+        libreDesfasada = false;
+    }
+
+public:
+    explicit ArbolConcurrente(const Comparar& comparar = Comparar())
+        : izquierda(comparar), derecha(comparar), publicada(0), libreDesfasada(false) {}
+
+    // Lectura: f(const Arbol&) corre sobre la copia publicada, que no cambia
+    // mientras f corre. Todo lo que f lea es una misma versión del árbol.
+    // f no debe guardar punteros, referencias ni iteradores a la copia
+    template <class F>
+    auto leer(F f) const -> decltype(f(declval<const Arbol&>())) {
+        GuardiaEpoca guardia(dominio);
+        return f(copia(publicada.load(memory_order_seq_cst)));
+    }
+
+    // Escritura: f(Arbol&) se aplica a las dos copias, una después de la
+    // otra, y los lectores pasan de la versión anterior a la nueva de una
+    // sola vez. f debe dejar las dos copias iguales (mismas operaciones, sin
+    // depender de nada que cambie entre llamadas). Devuelve lo que devolvió
+    // f en la primera copia.
+    //
+    // Si f lanza en la primera copia no se publica nada y la excepción se
+    // propaga; la copia a medias se rearma al empezar la próxima escritura.
+    // Si lanza en la segunda, la escritura ya es visible y se da por hecha:
+    // la segunda copia se rearma desde la publicada (o, si tampoco alcanza
+    // la memoria, al empezar la próxima escritura)
+    template <class F>
+    auto escribir(F f) -> decltype(f(declval<Arbol&>())) {
+        lock_guard<mutex> guardia(escritura);
+        int libre = 1 - publicada.load(memory_order_relaxed);
+        if (libreDesfasada) resincronizar(libre);
+        ResultadoEscritura<decltype(f(declval<Arbol&>()))> aplicar;
+        try {
+            aplicar.primera(f, copia(libre));
+        } catch (...) {
+            libreDesfasada = true;
+            throw;
+        }
+        publicada.store(libre, memory_order_seq_cst);
+        dominio.sincronizar();
+        try {
+            f(copia(1 - libre));
+        } catch (...) {
+            libreDesfasada = true;
+            try {
+                resincronizar(1 - libre);
+            } catch (...) {} // queda para la próxima escritura
+        }
+        return aplicar.resultado();
+    }
+
+    // Métodos públicos (seguros desde cualquier hilo)
+    
+    // Copia la información de clave en destino y dice si estaba. No puede
+    // devolver un puntero: la copia que lo contiene cambia en cuanto se
+    // cierra la guardia. Para leer sin copiar se usa leer()
+    template <class K>
+    bool buscar(const K& clave, Valor& destino) const {
+        GuardiaEpoca guardia(dominio);
+        const Valor* info = copia(publicada.load(memory_order_seq_cst)).buscar(clave);
+        if (info == nullptr) return false;
+        destino = *info;
+        return true;
+    }
+
+    void insertar(const Clave& clave, const Valor& info) {
+        escribir([&](Arbol& a) { a.insertar(clave, info); });
+    }
+
+    bool eliminar(const Clave& clave) {
+        return escribir([&](Arbol& a) { return a.eliminar(clave); });
+    }
+
+    bool modificar(const Clave& clave, const Valor& nuevaInfo) {
+        return escribir([&](Arbol& a) { return a.modificar(clave, nuevaInfo); });
+    }
+
+    size_t getTam() const {
+        return leer([](const Arbol& a) { return a.getTam(); });
+    }
+
+private:
+    ArbolConcurrente(const ArbolConcurrente&);            // no copiable
+    ArbolConcurrente& operator=(const ArbolConcurrente&);
+};
+
+#endif
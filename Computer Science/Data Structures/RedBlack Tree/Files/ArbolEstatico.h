@@ -0,0 +1,251 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Árbol RojiNegro estático: tablas de consulta fijas (códigos de estado,
+códigos de programa...) que se arman enteras en tiempo de compilación.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+// Todo es constexpr de C++11, así que un ArbolEstatico declarado constexpr
+// queda armado dentro del binario y no cuesta nada al iniciar el programa:
+//
+// - Los nodos viven en un arreglo de N posiciones y se enlazan por índices
+//   de 32 bits; no hay new, punteros ni std::string. Con claves de texto se
+//   usa const char*.
+// - La entrada es un arreglo de pares (clave, información) en orden
+//   estrictamente creciente. El nodo i guarda la entrada i, así que el
+//   arreglo ya está en inorden, y los enlaces son los de construirDesdeOrdenado
+//   de ArbolRojiNegro: la raíz de cada tramo es su elemento (n - 1) / 2 y,
+//   si el último nivel queda incompleto, sus nodos son rojos y el resto
+//   negros.
+// - Cada enlace y cada color se calcula con una función recursiva que
+//   desciende desde la raíz (C++11 no admite ciclos en constexpr): O(log N)
+//   por nodo. La comprobación del orden parte el arreglo en mitades para
+//   que la profundidad de la recursión sea O(log N) y no O(N).
+// - Si la entrada no está ordenada, armar el árbol en tiempo de compilación
+//   es un error de compilación; en tiempo de ejecución lanza
+//   invalid_argument.
+//
+// buscar también es constexpr: con una clave constante la búsqueda entera
+// puede hacerse al compilar (por ejemplo dentro de un static_assert).
+
+#ifndef ARBOLESTATICO_H
+#define ARBOLESTATICO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+
+// Orden de las claves. less<Clave> no es constexpr en C++11, así que se
+// compara con < y el texto (const char*) carácter por carácter
+template <class Clave>
+struct OrdenEstatico {
+    static constexpr bool menor(const Clave& a, const Clave& b) {
+        return a < b;
+    }
+};
+
+template <>
+struct OrdenEstatico<const char*> {
+    static constexpr bool menor(const char* a, const char* b) {
+        return *a != *b ? (unsigned char)*a < (unsigned char)*b : *a != '\0' && menor(a + 1, b + 1);
+    }
+};
+
+template <class Clave, class Valor>
+struct EntradaEstatica {
+    Clave clave;
+    Valor info;
+};
+
+template <class Clave, class Valor>
+struct NodoEstatico {
+    Clave clave;
+    Valor Info;
+    uint32_t izq, der; // índices en el arreglo; SIN_HIJO en lugar de NIL
+    bool color;        // true = ROJO, false = NEGRO
+};
+
+// Secuencia 0, 1, ..., N - 1 para expandir el arreglo de nodos. Se arma
+// uniendo mitades, con profundidad de instanciación O(log N)
+template <size_t... I>
+struct SecuenciaIndices {};
+
+template <class A, class B>
+struct UnirIndices;
+
+template <size_t... I, size_t... J>
+struct UnirIndices<SecuenciaIndices<I...>, SecuenciaIndices<J...> > {
+    typedef SecuenciaIndices<I..., (sizeof...(I) + J)...> tipo;
+};
+
+template <size_t N>
+struct GenerarIndices {
+    typedef typename UnirIndices<typename GenerarIndices<N / 2>::tipo,
+                                 typename GenerarIndices<N - N / 2>::tipo>::tipo tipo;
+};
+
+template <>
+struct GenerarIndices<0> {
+    typedef SecuenciaIndices<> tipo;
+};
+
+template <>
+struct GenerarIndices<1> {
+    typedef SecuenciaIndices<0> tipo;
+};
+
+template <class Clave, class Valor, size_t N, class Orden = OrdenEstatico<Clave> >
+class ArbolEstatico {
+public:
+    typedef EntradaEstatica<Clave, Valor> Entrada;
+    typedef NodoEstatico<Clave, Valor> nodo;
+
+    static const uint32_t SIN_HIJO = 0xFFFFFFFFu;
+    static const bool ROJO = true;
+    static const bool NEGRO = false;
+
+private:
+    static_assert(N > 0, "La tabla necesita al menos una entrada");
+    static_assert(N < SIN_HIJO, "Demasiadas entradas para índices de 32 bits");
+
+    nodo nodos[N];
+    uint32_t raiz;
+
+    // Raíz del tramo de n entradas que empieza en inicio (la misma división
+    // que construirBalanceado)
+    static constexpr size_t raizTramo(size_t inicio, size_t n) {
+        return inicio + (n - 1) / 2;
+    }
+
+    static constexpr uint32_t raizOSinHijo(size_t inicio, size_t n) {
+        return n == 0 ? SIN_HIJO : (uint32_t)raizTramo(inicio, n);
+    }
+
+    // Hijos y profundidad del nodo i, bajando desde el tramo [inicio, inicio + n)
+    static constexpr uint32_t izqDe(size_t i, size_t inicio, size_t n) {
+        return i == raizTramo(inicio, n) ? raizOSinHijo(inicio, (n - 1) / 2)
+             : i < raizTramo(inicio, n) ? izqDe(i, inicio, (n - 1) / 2)
+             : izqDe(i, raizTramo(inicio, n) + 1, n - (n - 1) / 2 - 1);
+    }
+
+    static constexpr uint32_t derDe(size_t i, size_t inicio, size_t n) {
+        return i == raizTramo(inicio, n) ? raizOSinHijo(raizTramo(inicio, n) + 1, n - (n - 1) / 2 - 1)
+             : i < raizTramo(inicio, n) ? derDe(i, inicio, (n - 1) / 2)
+             : derDe(i, raizTramo(inicio, n) + 1, n - (n - 1) / 2 - 1);
+    }
+
+    static constexpr size_t profundidadDe(size_t i, size_t inicio, size_t n, size_t prof) {
+        return i == raizTramo(inicio, n) ? prof
+             : i < raizTramo(inicio, n) ? profundidadDe(i, inicio, (n - 1) / 2, prof + 1)
+             : profundidadDe(i, raizTramo(inicio, n) + 1, n - (n - 1) / 2 - 1, prof + 1);
+    }
+
+    // Menor d con 2^(d + 1) - 1 >= n: la profundidad del último nivel
+    static constexpr size_t ultimoNivel(size_t n, size_t d) {
+        return ((size_t)2 << d) - 1 < n ? ultimoNivel(n, d + 1) : d;
+    }
+
+    // El último nivel es rojo solo si está incompleto
+    static constexpr bool esRojo(size_t i) {
+        return ((size_t)2 << ultimoNivel(N, 0)) - 1 != N && profundidadDe(i, 0, N, 0) == ultimoNivel(N, 0);
+    }
+
+    static constexpr nodo crearNodo(const Entrada (&e)[N], size_t i) {
+        return nodo{ e[i].clave, e[i].info, izqDe(i, 0, N), derDe(i, 0, N), esRojo(i) };
+    }
+
+    // Orden estricto en [inicio, fin), partiendo en mitades
+    static constexpr bool ordenadas(const Entrada (&e)[N], size_t inicio, size_t fin) {
+        return fin - inicio < 2 ||
+               (ordenadas(e, inicio, inicio + (fin - inicio) / 2) &&
+                ordenadas(e, inicio + (fin - inicio) / 2, fin) &&
+                Orden::menor(e[inicio + (fin - inicio) / 2 - 1].clave, e[inicio + (fin - inicio) / 2].clave));
+    }
+
+    template <size_t... I>
+    constexpr ArbolEstatico(const Entrada (&e)[N], SecuenciaIndices<I...>)
+        : nodos{ crearNodo(e, I)... },
+          raiz(ordenadas(e, 0, N) ? (uint32_t)raizTramo(0, N)
+                                  : throw invalid_argument("Las claves deben estar en orden estrictamente creciente")) {}
+
+    constexpr const Valor* buscarDesde(uint32_t i, const Clave& clave) const {
+        return i == SIN_HIJO ? nullptr
+             : Orden::menor(clave, nodos[i].clave) ? buscarDesde(nodos[i].izq, clave)
+             : Orden::menor(nodos[i].clave, clave) ? buscarDesde(nodos[i].der, clave)
+             : &nodos[i].Info;
+    }
+
+    static constexpr size_t mayor(size_t a, size_t b) {
+        return a > b ? a : b;
+    }
+
+    constexpr size_t alturaDesde(uint32_t i) const {
+        return i == SIN_HIJO ? 0 : 1 + mayor(alturaDesde(nodos[i].izq), alturaDesde(nodos[i].der));
+    }
+
+public:
+    // entradas: arreglo de pares en orden estrictamente creciente
+    constexpr explicit ArbolEstatico(const Entrada (&entradas)[N])
+        : ArbolEstatico(entradas, typename GenerarIndices<N>::tipo()) {}
+
+    // La información de la clave, o nullptr si no está
+    constexpr const Valor* buscar(const Clave& clave) const {
+        return buscarDesde(raiz, clave);
+    }
+
+    constexpr bool contiene(const Clave& clave) const {
+        return buscar(clave) != nullptr;
+    }
+
+    constexpr size_t getTam() const {
+        return N;
+    }
+
+    // Nodos desde la raíz hasta la hoja más lejana
+    constexpr size_t altura() const {
+        return alturaDesde(raiz);
+    }
+
+    // Acceso en inorden: la posición i es la i-ésima clave más chica
+    constexpr const nodo& operator[](size_t i) const {
+        return nodos[i];
+    }
+
+    constexpr const nodo& getRaiz() const {
+        return nodos[raiz];
+    }
+
+    const nodo* begin() const { return nodos; }
+    const nodo* end() const { return nodos + N; }
+
+    // Visita las entradas en inorden: visitar(clave, info)
+    template <class F>
+    void recorrerInorden(F visitar) const {
+        for (size_t i = 0; i < N; i++) visitar(nodos[i].clave, nodos[i].Info);
+    }
+};
+
+template <class Clave, class Valor, size_t N, class Orden>
+const uint32_t ArbolEstatico<Clave, Valor, N, Orden>::SIN_HIJO;
+template <class Clave, class Valor, size_t N, class Orden>
+const bool ArbolEstatico<Clave, Valor, N, Orden>::ROJO;
+template <class Clave, class Valor, size_t N, class Orden>
+const bool ArbolEstatico<Clave, Valor, N, Orden>::NEGRO;
+
+// Deduce N del arreglo:
+//     constexpr EntradaEstatica<int, const char*> CODIGOS[] = { { 200, "OK" }, { 404, "No encontrado" } };
+//     constexpr auto TABLA = crearArbolEstatico(CODIGOS);
+template <class Clave, class Valor, size_t N>
+constexpr ArbolEstatico<Clave, Valor, N> crearArbolEstatico(const EntradaEstatica<Clave, Valor> (&entradas)[N]) {
+    return ArbolEstatico<Clave, Valor, N>(entradas);
+}
+
+#endif
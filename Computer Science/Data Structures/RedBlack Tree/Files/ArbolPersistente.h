@@ -0,0 +1,433 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Versión persistente del Árbol RojiNegro: insertar, eliminar y modificar no
+cambian el árbol, devuelven una versión nueva que comparte con la anterior
+todo lo que no tocaron.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+// Árbol RojiNegro inclinado a la izquierda (Sedgewick, "Left-leaning
+// Red-Black Trees"): todo enlace rojo es un hijo izquierdo, y los ajustes
+// se hacen de arriba hacia abajo y de regreso por la misma recursión, sin
+// punteros al padre. Eso permite copiar caminos:
+//
+// - Una versión es un puntero a la raíz. Copiar una versión (la
+//   instantánea) es O(1): solo suma una referencia a la raíz.
+// - Cada operación copia los O(log n) nodos del camino que recorre (y los
+//   hermanos que recolorea); el resto del árbol se comparte.
+// - Cada nodo cuenta sus referencias (de versiones y de padres) con un
+//   contador atómico. Al soltar la última se libera, y con él sus hijos
+//   que nadie más usa.
+//
+// Una versión nunca cambia: varios hilos pueden leerla a la vez, y objetos
+// distintos que comparten nodos se pueden copiar, asignar y destruir desde
+// hilos distintos. La clase no tiene candados propios: como con
+// shared_ptr, asignar un mismo objeto ArbolPersistente desde un hilo
+// mientras otro lo lee o lo copia es una carrera de datos. Si varios hilos
+// comparten una versión "actual", quien la usa debe protegerla con su
+// propio mutex, al menos mientras la copia o la reemplaza (O(1)).
+
+#ifndef ARBOLPERSISTENTE_H
+#define ARBOLPERSISTENTE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <stack>
+#include <string>
+using namespace std;
+
+template <class Clave, class Valor>
+struct NodoPersistente {
+    Clave clave;
+    Valor Info;
+    NodoPersistente *izq, *der;   // nullptr en lugar de NIL
+    bool color;                   // true = ROJO, false = NEGRO
+    size_t tam;                   // nodos del subárbol
+    atomic<int> refs;             // versiones y padres que lo apuntan
+
+    NodoPersistente(const Clave& c, const Valor& v, NodoPersistente* i, NodoPersistente* d, bool col)
+        : clave(c), Info(v), izq(i), der(d), color(col), tam(1), refs(1) {}
+};
+
+template <class Clave = int, class Valor = string, class Comparar = less<Clave> >
+class ArbolPersistente {
+private:
+    typedef NodoPersistente<Clave, Valor> nodo;
+
+    static const bool ROJO = true;
+    static const bool NEGRO = false;
+
+    nodo* raiz;   // la versión: una referencia propia a la raíz
+    Comparar comp;
+
+    ArbolPersistente(nodo* r, const Comparar& c) : raiz(r), comp(c) {} // adopta la referencia
+
+    // -------------------------------------------------
+    // Referencias
+    // -------------------------------------------------
+    static void retener(nodo* n) {
+        if (n != nullptr) n->refs.fetch_add(1, memory_order_relaxed);
+    }
+
+    static void soltar(nodo* n) {
+        while (n != nullptr && n->refs.fetch_sub(1, memory_order_acq_rel) == 1) {
+            soltar(n->izq);
+            nodo* der = n->der; // el hijo derecho sin recursión
+            delete n;
+            n = der;
+        }
+    }
+
+    // Recibe una referencia propia a n y devuelve un nodo que solo usa quien
+    // llama: el mismo si nadie más lo apunta, o una copia que retiene a los
+    // hijos
+    static nodo* propio(nodo* n) {
+        if (n->refs.load(memory_order_acquire) == 1) return n;
+        nodo* copia = new nodo(n->clave, n->Info, n->izq, n->der, n->color);
+        copia->tam = n->tam;
+        retener(n->izq);
+        retener(n->der);
+        soltar(n);
+        return copia;
+    }
+
+    // -------------------------------------------------
+    // Ajustes (sobre nodos propios)
+    // -------------------------------------------------
+    static bool esRojo(const nodo* n) { return n != nullptr && n->color == ROJO; }
+    static size_t tamDe(const nodo* n) { return n == nullptr ? 0 : n->tam; }
+    static void actualizar(nodo* n) { n->tam = 1 + tamDe(n->izq) + tamDe(n->der); }
+
+    static nodo* rotarIzquierda(nodo* h) {
+        nodo* x = propio(h->der);
+        h->der = x->izq;
+        x->izq = h;
+        x->color = h->color;
+        h->color = ROJO;
+        actualizar(h);
+        actualizar(x);
+        return x;
+    }
+
+    static nodo* rotarDerecha(nodo* h) {
+        nodo* x = propio(h->izq);
+        h->izq = x->der;
+        x->der = h;
+        x->color = h->color;
+        h->color = ROJO;
+        actualizar(h);
+        actualizar(x);
+        return x;
+    }
+
+    // Invierte los colores de h y de sus dos hijos
+    static void invertirColores(nodo* h) {
+        h->color = !h->color;
+        h->izq = propio(h->izq);
+        h->izq->color = !h->izq->color;
+        h->der = propio(h->der);
+        h->der->color = !h->der->color;
+    }
+
+    // Restablece la inclinación a la izquierda al volver de la recursión
+    static nodo* balancear(nodo* h) {
+        if (esRojo(h->der) && !esRojo(h->izq)) h = rotarIzquierda(h);
+        if (esRojo(h->izq) && esRojo(h->izq->izq)) h = rotarDerecha(h);
+        if (esRojo(h->izq) && esRojo(h->der)) invertirColores(h);
+        actualizar(h);
+        return h;
+    }
+
+    // Deja rojo a h->izq o a uno de sus hijos antes de bajar por la izquierda
+    static nodo* moverRojoIzquierda(nodo* h) {
+        invertirColores(h);
+        if (esRojo(h->der->izq)) {
+            h->der = rotarDerecha(h->der);
+            h = rotarIzquierda(h);
+            invertirColores(h);
+        }
+        return h;
+    }
+
+    static nodo* moverRojoDerecha(nodo* h) {
+        invertirColores(h);
+        if (esRojo(h->izq->izq)) {
+            h = rotarDerecha(h);
+            invertirColores(h);
+        }
+        return h;
+    }
+
+    // -------------------------------------------------
+    // Recursiones: reciben una referencia propia y devuelven otra
+    // -------------------------------------------------
+    nodo* insertarRec(nodo* h, const Clave& clave, const Valor& info) const {
+        if (h == nullptr) return new nodo(clave, info, nullptr, nullptr, ROJO);
+        h = propio(h);
+        if (comp(clave, h->clave))
+            h->izq = insertarRec(h->izq, clave, info);
+        else
+            h->der = insertarRec(h->der, clave, info); // repetidas a la derecha, como en ArbolRojiNegro
+        return balancear(h);
+    }
+
+    static nodo* eliminarMinimo(nodo* h) {
+        if (h->izq == nullptr) {
+            soltar(h);
+            return nullptr;
+        }
+        h = propio(h);
+        if (!esRojo(h->izq) && !esRojo(h->izq->izq)) h = moverRojoIzquierda(h);
+        h->izq = eliminarMinimo(h->izq);
+        return balancear(h);
+    }
+
+    // La clave está en el subárbol de h (se comprueba antes de bajar)
+    nodo* eliminarRec(nodo* h, const Clave& clave) const {
+        h = propio(h);
+        if (comp(clave, h->clave)) {
+            if (!esRojo(h->izq) && !esRojo(h->izq->izq)) h = moverRojoIzquierda(h);
+            h->izq = eliminarRec(h->izq, clave);
+        } else {
+            // Se decide antes de rotar si h es la ocurrencia a eliminar: una
+            // rotación a la derecha deja arriba un nodo anterior a h, que con
+            // claves repetidas puede ser igual y no debe tomarse por h
+            bool aqui = !comp(h->clave, clave);
+            if (esRojo(h->izq)) {
+                h = rotarDerecha(h);
+                aqui = false;
+            }
+            if (aqui && h->der == nullptr) {
+                soltar(h);
+                return nullptr;
+            }
+            if (!esRojo(h->der) && !esRojo(h->der->izq)) {
+                nodo* antes = h;
+                h = moverRojoDerecha(h);
+                if (h != antes) aqui = false;
+            }
+            if (aqui) {
+                // Se reemplaza por el sucesor y se elimina el sucesor
+                const nodo* sucesor = h->der;
+                while (sucesor->izq != nullptr) sucesor = sucesor->izq;
+                h->clave = sucesor->clave;
+                h->Info = sucesor->Info;
+                h->der = eliminarMinimo(h->der);
+            } else {
+                h->der = eliminarRec(h->der, clave);
+            }
+        }
+        return balancear(h);
+    }
+
+    nodo* modificarRec(nodo* h, const Clave& clave, const Valor& nuevaInfo) const {
+        h = propio(h);
+        if (comp(clave, h->clave))
+            h->izq = modificarRec(h->izq, clave, nuevaInfo);
+        else if (comp(h->clave, clave))
+            h->der = modificarRec(h->der, clave, nuevaInfo);
+        else
+            h->Info = nuevaInfo;
+        return h;
+    }
+
+    const nodo* ubicar(const Clave& clave) const {
+        const nodo* x = raiz;
+        while (x != nullptr) {
+            if (comp(clave, x->clave)) x = x->izq;
+            else if (comp(x->clave, clave)) x = x->der;
+            else return x;
+        }
+        return nullptr;
+    }
+
+    // Entrega la referencia de esta versión a la raíz (queda vacía)
+    nodo* soltarRaiz() {
+        nodo* r = raiz;
+        raiz = nullptr;
+        return r;
+    }
+
+    // Elimina desde una referencia propia a la raíz, que tiene la clave
+    nodo* eliminarDesde(nodo* r, const Clave& clave) const {
+        r = propio(r);
+        if (!esRojo(r->izq) && !esRojo(r->der)) r->color = ROJO;
+        return eliminarRec(r, clave);
+    }
+
+    // Nueva versión con la raíz propia dada, que se deja negra
+    ArbolPersistente version(nodo* r) const {
+        if (r != nullptr && r->color == ROJO) {
+            r = propio(r);
+            r->color = NEGRO;
+        }
+        return ArbolPersistente(r, comp);
+    }
+
+public:
+    // Versión vacía
+    explicit ArbolPersistente(const Comparar& comparar = Comparar()) : raiz(nullptr), comp(comparar) {}
+
+    // Copiar es tomar una instantánea: O(1)
+    ArbolPersistente(const ArbolPersistente& otra) : raiz(otra.raiz), comp(otra.comp) { retener(raiz); }
+
+    ArbolPersistente(ArbolPersistente&& otra) : raiz(otra.raiz), comp(otra.comp) { otra.raiz = nullptr; }
+
+    ArbolPersistente& operator=(const ArbolPersistente& otra) {
+        retener(otra.raiz);
+        soltar(raiz);
+        raiz = otra.raiz;
+        comp = otra.comp;
+        return *this;
+    }
+
+    ArbolPersistente& operator=(ArbolPersistente&& otra) {
+        if (this != &otra) {
+            soltar(raiz);
+            raiz = otra.raiz;
+            comp = otra.comp;
+            otra.raiz = nullptr;
+        }
+        return *this;
+    }
+
+    ~ArbolPersistente() { soltar(raiz); }
+
+    ArbolPersistente instantanea() const { return *this; }
+
+    // Operaciones: devuelven la versión nueva y no cambian esta.
+    //
+    // Sobre una versión que se descarta (v = move(v).insertar(...)) los nodos
+    // que solo ella usa se cambian en el lugar en vez de copiarse; los que
+    // comparte con instantáneas se copian igual
+    ArbolPersistente insertar(const Clave& clave, const Valor& info) const & {
+        retener(raiz);
+        return version(insertarRec(raiz, clave, info));
+    }
+
+    ArbolPersistente insertar(const Clave& clave, const Valor& info) && {
+        return version(insertarRec(soltarRaiz(), clave, info));
+    }
+
+    // Elimina una ocurrencia de la clave (sin ella, devuelve esta misma versión)
+    ArbolPersistente eliminar(const Clave& clave) const & {
+        if (ubicar(clave) == nullptr) return *this;
+        retener(raiz);
+        return version(eliminarDesde(raiz, clave));
+    }
+
+    ArbolPersistente eliminar(const Clave& clave) && {
+        if (ubicar(clave) == nullptr) return move(*this);
+        return version(eliminarDesde(soltarRaiz(), clave));
+    }
+
+    ArbolPersistente modificar(const Clave& clave, const Valor& nuevaInfo) const & {
+        if (ubicar(clave) == nullptr) return *this;
+        retener(raiz);
+        return ArbolPersistente(modificarRec(raiz, clave, nuevaInfo), comp);
+    }
+
+    ArbolPersistente modificar(const Clave& clave, const Valor& nuevaInfo) && {
+        if (ubicar(clave) == nullptr) return move(*this);
+        return ArbolPersistente(modificarRec(soltarRaiz(), clave, nuevaInfo), comp);
+    }
+
+    // Consultas
+    // La información de clave, o nullptr si no está. Los nodos de una
+    // versión no cambian: el puntero vale mientras viva alguna versión que
+    // lo contenga
+    const Valor* buscar(const Clave& clave) const {
+        const nodo* x = ubicar(clave);
+        return x != nullptr ? &x->Info : nullptr;
+    }
+
+    bool contiene(const Clave& clave) const { return ubicar(clave) != nullptr; }
+
+    size_t getTam() const { return tamDe(raiz); }
+
+    // Dos versiones con la misma raíz son iguales sin comparar nodos
+    bool mismaVersion(const ArbolPersistente& otra) const { return raiz == otra.raiz; }
+
+    // Llama a visitar(clave, info) en orden
+    template <class F>
+    void recorrerInorden(F visitar) const {
+        stack<const nodo*> pendientes;
+        const nodo* x = raiz;
+        while (x != nullptr || !pendientes.empty()) {
+            while (x != nullptr) {
+                pendientes.push(x);
+                x = x->izq;
+            }
+            x = pendientes.top();
+            pendientes.pop();
+            visitar(x->clave, x->Info);
+            x = x->der;
+        }
+    }
+
+    // Recorridos (iterativos, como en ArbolRojiNegro)
+    queue<Clave> inorden() const {
+        queue<Clave> resultado;
+        recorrerInorden([&](const Clave& clave, const Valor&) { resultado.push(clave); });
+        return resultado;
+    }
+
+    queue<Clave> preorden() const {
+        queue<Clave> resultado;
+        stack<const nodo*> pendientes;
+        if (raiz != nullptr) pendientes.push(raiz);
+        while (!pendientes.empty()) {
+            const nodo* x = pendientes.top();
+            pendientes.pop();
+            resultado.push(x->clave);
+            if (x->der != nullptr) pendientes.push(x->der);
+            if (x->izq != nullptr) pendientes.push(x->izq);
+        }
+        return resultado;
+    }
+
+    queue<Clave> posorden() const {
+        // preorden espejado (raíz, derecha, izquierda) leído al revés
+        stack<const nodo*> pendientes;
+        stack<Clave> salida;
+        if (raiz != nullptr) pendientes.push(raiz);
+        while (!pendientes.empty()) {
+            const nodo* x = pendientes.top();
+            pendientes.pop();
+            salida.push(x->clave);
+            if (x->izq != nullptr) pendientes.push(x->izq);
+            if (x->der != nullptr) pendientes.push(x->der);
+        }
+        queue<Clave> resultado;
+        while (!salida.empty()) {
+            resultado.push(salida.top());
+            salida.pop();
+        }
+        return resultado;
+    }
+
+    queue<Clave> porNiveles() const {
+        queue<Clave> resultado;
+        queue<const nodo*> nivel;
+        if (raiz != nullptr) nivel.push(raiz);
+        while (!nivel.empty()) {
+            const nodo* x = nivel.front();
+            nivel.pop();
+            resultado.push(x->clave);
+            if (x->izq != nullptr) nivel.push(x->izq);
+            if (x->der != nullptr) nivel.push(x->der);
+        }
+        return resultado;
+    }
+};
+
+#endif
@@ -15,123 +15,592 @@ Ian Nicolás Sandoval Martínez (20241020078)
 #ifndef ARBOLROJINEGRO_H
 #define ARBOLROJINEGRO_H
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
 #include <string>
 #include <queue>
 #include <stack>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Instrumentación opcional (compilar con -DARBOL_INSTRUMENTADO): rotaciones,
+// recoloreos, casos de los ajustes, profundidad de los descensos y
+// reservas de nodos. Si no se activa, las macros quedan vacías y no
+// agregan ningún costo
+#ifdef ARBOL_INSTRUMENTADO
+#include "../../Tools/Files/instrumentacion.h"
+#else
+#define ARBOL_REGISTRAR_ROTACION(lado)
+#define ARBOL_REGISTRAR_RECOLOREO(n)
+#define ARBOL_REGISTRAR_CASO(caso)
+#define ARBOL_INICIAR_PASOS()
+#define ARBOL_CONTAR_PASO()
+#define ARBOL_REGISTRAR_AJUSTE(ajuste)
+#define ARBOL_REGISTRAR_DESCENSO(descenso)
+#define ARBOL_REGISTRAR_RESERVAS(n)
+#define ARBOL_REGISTRAR_LIBERACION()
+#define ARBOL_REGISTRAR_BLOQUE(bytes)
+#endif
+
 using namespace std;
 
-#define ROJO true
-#define NEGRO false
+// Agregados por subárbol
+//
+// Un agregado es un monoide que cada nodo guarda para todo su subárbol, como
+// ya hace con tam. Es una clase con:
+//   typedef ... Tipo;
+//   static Tipo neutro();                               // el de un subárbol vacío
+//   static Tipo deNodo(const Clave&, const Valor&);     // el de un solo nodo
+//   static Tipo combinar(const Tipo& a, const Tipo& b); // asociativa; a va antes que b
+// El árbol lo recalcula en el mismo actualizar(n) que mantiene tam, así que
+// lo conservan las rotaciones, los ajustes, unir/dividir y la carga masiva.
+
+// Sin agregado (lo normal): Tipo es vacío y el nodo no guarda nada
+struct SinAgregado {
+    struct Vacio {};
+    typedef Vacio Tipo;
+    static Tipo neutro() { return Tipo(); }
+    template <class Clave, class Valor>
+    static Tipo deNodo(const Clave&, const Valor&) { return Tipo(); }
+    static Tipo combinar(const Tipo&, const Tipo&) { return Tipo(); }
+};
+
+// Suma, mínimo y máximo de la información (numérica)
+template <class T>
+struct AgregadoSuma {
+    typedef T Tipo;
+    static Tipo neutro() { return T(); }
+    template <class Clave>
+    static Tipo deNodo(const Clave&, const T& info) { return info; }
+    static Tipo combinar(const Tipo& a, const Tipo& b) { return a + b; }
+};
 
-// Estructura del nodo según especificación
-struct nodo {
-    int clave;
-    string Info;
-    nodo *izq, *der, *padre;
+template <class T>
+struct AgregadoMinimo {
+    typedef T Tipo;
+    static Tipo neutro() { return numeric_limits<T>::has_infinity ? numeric_limits<T>::infinity() : numeric_limits<T>::max(); }
+    template <class Clave>
+    static Tipo deNodo(const Clave&, const T& info) { return info; }
+    static Tipo combinar(const Tipo& a, const Tipo& b) { return b < a ? b : a; }
+};
+
+template <class T>
+struct AgregadoMaximo {
+    typedef T Tipo;
+    static Tipo neutro() { return numeric_limits<T>::has_infinity ? -numeric_limits<T>::infinity() : numeric_limits<T>::lowest(); }
+    template <class Clave>
+    static Tipo deNodo(const Clave&, const T& info) { return info; }
+    static Tipo combinar(const Tipo& a, const Tipo& b) { return a < b ? b : a; }
+};
+
+// Campo del agregado en el nodo. Un Tipo vacío no ocupa espacio: el nodo
+// hereda de la especialización sin miembros (optimización de base vacía)
+template <class T, bool vacio = is_empty<T>::value>
+struct CampoAgregado {
+    T agregado;
+};
+
+template <class T>
+struct CampoAgregado<T, true> {};
+
+// Estructura del nodo según especificación. La clave y la información van
+// dentro del nodo: un Valor trivialmente copiable (int, double, un struct de
+// enteros...) no reserva nada aparte del propio nodo.
+template <class Clave, class Valor, class Agregado = SinAgregado>
+struct NodoRN : CampoAgregado<typename Agregado::Tipo> {
+    Clave clave;
+    Valor Info;
+    NodoRN *izq, *der, *padre;
     bool color; // true = ROJO, false = NEGRO
+    size_t tam; // nodos del subárbol que empieza aquí (NIL = 0)
+};
+
+// Comparador "transparente": permite buscar con un tipo distinto a la clave
+// (por ejemplo un const char* o un string_view en un árbol de string) sin
+// construir una clave temporal
+struct ComparadorTransparente {
+    typedef void is_transparent;
+
+    template <class A, class B>
+    bool operator()(const A& a, const B& b) const { return a < b; }
+};
+
+// Pide a la caché la línea de p sin esperarla (no hace nada si el
+// compilador no lo soporta)
+#if defined(__GNUC__)
+#define ARBOL_PRECARGAR(p) __builtin_prefetch(p)
+#else
+#define ARBOL_PRECARGAR(p) ((void)0)
+#endif
+
+// Ejecutor de las operaciones de conjuntos que corre todo en el hilo que
+// llama. Para correrlas en paralelo se pasa un PoolHilos
+// (Tools/Files/pool_hilos.h) o cualquier clase con el mismo dividir
+struct EjecucionSecuencial {
+    template <class F1, class F2>
+    void dividir(F1 f1, F2 f2) {
+        f1();
+        f2();
+    }
 };
 
 // Clase del Árbol RojiNegro
+//
+// Clave: tipo de la clave (int, long long, pair<int, int>, string...)
+// Valor: información guardada con cada clave
+// Comparar: orden estricto de las claves; si define is_transparent,
+//           buscar acepta cualquier tipo comparable con la clave
+// Agregado: monoide guardado por subárbol para agregar(a, b) y
+//           recorrerPodando (ver SinAgregado); por defecto ninguno
+template <class Clave = int, class Valor = string, class Comparar = less<Clave>, class Agregado = SinAgregado>
 class ArbolRojiNegro {
+public:
+    typedef typename Agregado::Tipo TipoAgregado;
+
 private:
+    typedef NodoRN<Clave, Valor, Agregado> nodo;
+    
+    // Sin agregado no hay campo que mantener
+    typedef integral_constant<bool, !is_empty<TipoAgregado>::value> hayAgregado;
+
+    static const bool ROJO = true;
+    static const bool NEGRO = false;
+
     nodo* raiz;
     nodo* NIL; // centinela
+    Comparar comp;
+    
+    // Copia congelada para lecturas (ver congelar): las claves en orden de
+    // Eytzinger (la raíz en la posición 1 y los hijos de i en 2i y 2i + 1)
+    // y su información en las mismas posiciones. Cualquier cambio al árbol
+    // la descarta
+    bool congelado;
+    vector<Clave> clavesCongeladas;
+    vector<Valor> infoCongelada;
+    
+    // Claves por línea de caché: la precarga de la posición ADELANTO * i
+    // trae los descendientes de i cuatro niveles más abajo (con int)
+    static const size_t ADELANTO = sizeof(Clave) < 64 ? 64 / sizeof(Clave) : 1;
+    
+    void descongelar() {
+        if (congelado) {
+            congelado = false;
+            vector<Clave>().swap(clavesCongeladas);
+            vector<Valor>().swap(infoCongelada);
+        }
+    }
+    
+    // Inorden del árbol -> posiciones de Eytzinger, desde k
+    void llenarEytzinger(size_t k, nodo*& siguiente) {
+        if (k >= clavesCongeladas.size()) return;
+        llenarEytzinger(2 * k, siguiente);
+        clavesCongeladas[k] = siguiente->clave;
+        infoCongelada[k] = siguiente->Info;
+        siguiente = sucesor(siguiente);
+        llenarEytzinger(2 * k + 1, siguiente);
+    }
+    
+    static int unosFinales(size_t i) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(~(unsigned long long)i);
+#else
+        int c = 0;
+        for (; i & 1; i >>= 1) c++;
+        return c;
+#endif
+    }
+    
+    // Búsqueda sin saltos en la copia congelada: en cada nivel el índice
+    // avanza a 2i o 2i + 1 según la comparación (un 0 o un 1, sin if). Al
+    // salir, quitar los pasos a la derecha del final deja en i la primera
+    // clave que no es menor que la buscada
+    template <class K>
+    const Valor* buscarCongelado(const K& clave) const {
+        const Clave* a = &clavesCongeladas[0];
+        size_t n = clavesCongeladas.size() - 1;
+        size_t i = 1;
+        while (i <= n) {
+            if (ADELANTO * i <= n) ARBOL_PRECARGAR(a + ADELANTO * i);
+            i = 2 * i + (comp(a[i], clave) ? 1 : 0);
+        }
+        i >>= unosFinales(i) + 1;
+        if (i == 0 || comp(clave, a[i])) return nullptr;
+        return &infoCongelada[i];
+    }
+    
+    // Reserva de nodos: bloques de memoria sin construir que se reparten en
+    // orden, y una lista de libres (enlazada por izq) con los nodos eliminados.
+    // La memoria de los bloques se devuelve al destruir o vaciar el árbol
+    static const size_t BLOQUE_MINIMO = 64;
+    static const size_t BLOQUE_MAXIMO = 65536;
+    vector<nodo*> bloques;
+    nodo* bloqueActual;
+    size_t usadosBloque, capacidadBloque;
+    nodo* libres;
+    
+    nodo* reservarNodo() {
+        ARBOL_REGISTRAR_RESERVAS(1);
+        if (libres != nullptr) {
+            nodo* n = libres;
+            libres = libres->izq;
+            return n;
+        }
+        if (usadosBloque == capacidadBloque) {
+            // Cada bloque dobla al anterior hasta BLOQUE_MAXIMO nodos
+            size_t capacidad = capacidadBloque * 2;
+            if (capacidad < BLOQUE_MINIMO) capacidad = BLOQUE_MINIMO;
+            if (capacidad > BLOQUE_MAXIMO) capacidad = BLOQUE_MAXIMO;
+            bloqueActual = nuevoBloque(capacidad);
+            usadosBloque = 0;
+            capacidadBloque = capacidad;
+        }
+        return &bloqueActual[usadosBloque++];
+    }
+    
+    nodo* nuevoBloque(size_t capacidad) {
+        nodo* bloque = static_cast<nodo*>(::operator new(capacidad * sizeof(nodo)));
+        ARBOL_REGISTRAR_BLOQUE(capacidad * sizeof(nodo));
+        bloques.push_back(bloque);
+        return bloque;
+    }
+    
+    // Construye la clave, la información y el agregado en un nodo sin
+    // construir; la información se construye en su lugar con args (una
+    // copia, un valor movido o los argumentos de un constructor de Valor).
+    // Si un constructor lanza, destruye lo que alcanzó a construir y el
+    // nodo queda otra vez sin construir
+    template <class... Args>
+    void construirNodo(nodo* z, const Clave& clave, Args&&... args) {
+        new (&z->clave) Clave(clave);
+        try {
+            new (&z->Info) Valor(forward<Args>(args)...);
+            try {
+                construirAgregado(z, hayAgregado());
+            } catch (...) {
+                z->Info.~Valor();
+                throw;
+            }
+        } catch (...) {
+            z->clave.~Clave();
+            throw;
+        }
+    }
+    
+    void destruirNodo(nodo* n) {
+        n->clave.~Clave();
+        n->Info.~Valor();
+        destruirAgregado(n, hayAgregado());
+    }
+    
+    // Reserva y construye un nodo suelto. Si algo lanza, el nodo vuelve a
+    // la lista de libres y el árbol no cambia
+    template <class... Args>
+    nodo* crearNodo(const Clave& clave, Args&&... args) {
+        nodo* z = reservarNodo();
+        try {
+            construirNodo(z, clave, forward<Args>(args)...);
+        } catch (...) {
+            devolverNodo(z);
+            throw;
+        }
+        z->izq = z->der = z->padre = NIL;
+        z->color = ROJO;
+        z->tam = 1;
+        try {
+            actualizarAgregado(z, hayAgregado());
+        } catch (...) {
+            liberarNodo(z);
+            throw;
+        }
+        return z;
+    }
+    
+    // Devuelve a la lista de libres un nodo sin construir
+    void devolverNodo(nodo* n) {
+        ARBOL_REGISTRAR_LIBERACION();
+        n->izq = libres;
+        libres = n;
+    }
+    
+    void liberarNodo(nodo* n) {
+        destruirNodo(n);
+        devolverNodo(n);
+    }
     
     // Métodos
     
     // Buscar nodo
-    nodo* buscarNodo(int clave) {
+    template <class K>
+    nodo* buscarNodo(const K& clave) const {
         nodo* actual = raiz; // aux en raíz
-        while (actual != NIL && actual->clave != clave) { // apunta a la clave hasta encontrarla por izq o der
-            if (clave < actual->clave)
+        ARBOL_INICIAR_PASOS();
+        while (actual != NIL) { // apunta a la clave hasta encontrarla por izq o der
+            ARBOL_CONTAR_PASO();
+            if (comp(clave, actual->clave))
                 actual = actual->izq;
-            else
+            else if (comp(actual->clave, clave))
                 actual = actual->der;
+            else
+                break;
         }
+        ARBOL_REGISTRAR_DESCENSO(DESCENSO_BUSQUEDA);
         return actual; // retorna el nodo que tiene la clave buscada
     }
     
     
-    nodo* minimo(nodo* n) {
+    // Recalcula los datos del subárbol de n a partir de sus hijos
+    void actualizar(nodo* n) {
+        n->tam = n->izq->tam + n->der->tam + 1;
+        actualizarAgregado(n, hayAgregado());
+    }
+    
+    void actualizarAgregado(nodo*, false_type) {}
+    
+    void actualizarAgregado(nodo* n, true_type) {
+        n->agregado = Agregado::combinar(Agregado::combinar(n->izq->agregado, Agregado::deNodo(n->clave, n->Info)),
+                                         n->der->agregado);
+    }
+    
+    // Tras cambiar la información de n: su agregado y el de sus ancestros
+    void infoCambiada(nodo*, false_type) {}
+    
+    void infoCambiada(nodo* n, true_type) {
+        actualizarCamino(n);
+    }
+    
+    // Los nodos salen de memoria sin construir, como la clave y la
+    // información, el agregado se construye y se destruye a mano
+    void construirAgregado(nodo*, false_type) {}
+    
+    void construirAgregado(nodo* n, true_type) {
+        new (&n->agregado) TipoAgregado(Agregado::neutro());
+    }
+    
+    void destruirAgregado(nodo*, false_type) {}
+    
+    void destruirAgregado(nodo* n, true_type) {
+        n->agregado.~TipoAgregado();
+    }
+    
+    // El centinela lleva el neutro: así un hijo NIL no es un caso aparte
+    void fijarNeutro(nodo*, false_type) {}
+    
+    void fijarNeutro(nodo* n, true_type) {
+        n->agregado = Agregado::neutro();
+    }
+    
+    // Actualiza n y todos sus ancestros hasta la raíz
+    void actualizarCamino(nodo* n) {
+        while (n != NIL) {
+            actualizar(n);
+            n = n->padre;
+        }
+    }
+    
+    // Cuántas claves son menores que clave (o menores o iguales)
+    template <class K>
+    size_t contarMenores(const K& clave, bool incluirIguales) const {
+        size_t cuenta = 0;
+        nodo* n = raiz;
+        while (n != NIL) {
+            bool aLaDerecha = incluirIguales ? !comp(clave, n->clave) : comp(n->clave, clave);
+            if (aLaDerecha) {
+                cuenta += n->izq->tam + 1; // n y todo su subárbol izquierdo
+                n = n->der;
+            } else {
+                n = n->izq;
+            }
+        }
+        return cuenta;
+    }
+    
+    nodo* minimo(nodo* n) const {
+        if (n == NIL) return NIL; // árbol vacío
         while (n->izq != NIL) // mientras haya hijo izq ir al max izq que es el menor
             n = n->izq;
         return n;
     }
     
+    nodo* maximo(nodo* n) const {
+        if (n == NIL) return NIL;
+        while (n->der != NIL)
+            n = n->der;
+        return n;
+    }
+    
+    // Siguiente nodo en inorden (NIL después del último), subiendo por padre
+    nodo* sucesor(nodo* n) const {
+        if (n->der != NIL)
+            return minimo(n->der);
+        nodo* p = n->padre;
+        while (p != NIL && n == p->der) { // subimos mientras vengamos de la derecha
+            n = p;
+            p = p->padre;
+        }
+        return p;
+    }
+    
+    // Nodo anterior en inorden (NIL antes del primero)
+    nodo* predecesor(nodo* n) const {
+        if (n->izq != NIL)
+            return maximo(n->izq);
+        nodo* p = n->padre;
+        while (p != NIL && n == p->izq) {
+            n = p;
+            p = p->padre;
+        }
+        return p;
+    }
+    
+    // Primer nodo del posorden dentro del subárbol de n
+    nodo* primeroPosorden(nodo* n) const {
+        while (true) {
+            if (n->izq != NIL) n = n->izq;
+            else if (n->der != NIL) n = n->der;
+            else return n;
+        }
+    }
+    
+    // Visita en orden los nodos que están a profundidad d; dice si hubo alguno
+    template <class F>
+    bool visitarNivel(size_t d, F& visitar) const {
+        if (raiz == NIL) return false;
+        nodo* n = raiz;
+        size_t profundidad = 0;
+        bool hubo = false;
+        while (true) {
+            if (profundidad == d) {
+                visitar(n->clave, n->Info);
+                hubo = true;
+            } else if (n->izq != NIL || n->der != NIL) { // bajamos por el primer hijo
+                n = n->izq != NIL ? n->izq : n->der;
+                profundidad++;
+                continue;
+            }
+            // subimos hasta el primer ancestro con un hijo derecho sin visitar
+            while (true) {
+                nodo* p = n->padre;
+                if (p == NIL) return hubo;
+                if (n == p->izq && p->der != NIL) {
+                    n = p->der;
+                    break;
+                }
+                n = p;
+                profundidad--;
+            }
+        }
+    }
+    
     // Algoritmos de Rotación izq - der
     
-    void rotarIzquierda(nodo* x) { 
+    // r es la raíz del árbol que se rota: la del objeto o la de un subárbol
+    // suelto durante unir/dividir
+    void rotarIzquierda(nodo* x, nodo*& r) { 
         nodo* y = x->der; // y como la der. de x
         x->der = y->izq; // transplante del subarbol
         if (y->izq != NIL) 
             y->izq->padre = x; // actualizamos el padre de y a x
         y->padre = x->padre; // transplante x, y
         if (x->padre == NIL) // si x era raíz ahora y es raíz
-            raiz = y;
+            r = y;
         else if (x == x->padre->izq) // si x era hijo izquierdo y lo reemplaza
             x->padre->izq = y;
         else // si x era hijo derecho y lo reemplaza
             x->padre->der = y;
         y->izq = x; // x hijo izq. de y
         x->padre = y; // y padre de x
+        actualizar(x); // primero x, que ahora es hijo de y
+        actualizar(y);
+        ARBOL_REGISTRAR_ROTACION(ROTACION_IZQUIERDA);
     }
     
-    void rotarDerecha(nodo* x) { // Función espejo de rotarIzquierda
+    void rotarDerecha(nodo* x, nodo*& r) { // Función espejo de rotarIzquierda
         nodo* y = x->izq;
         x->izq = y->der;
         if (y->der != NIL)
             y->der->padre = x;
         y->padre = x->padre;
         if (x->padre == NIL)
-            raiz = y;
+            r = y;
         else if (x == x->padre->der)
             x->padre->der = y;
         else
             x->padre->izq = y;
         y->der = x;
         x->padre = y;
+        actualizar(x);
+        actualizar(y);
+        ARBOL_REGISTRAR_ROTACION(ROTACION_DERECHA);
     }
     
-    // Algoritmo en base al libro de Thomas H. Cormen
-    void ajustarInsercion(nodo* z) {
+    void rotarIzquierda(nodo* x) { rotarIzquierda(x, raiz); }
+    void rotarDerecha(nodo* x) { rotarDerecha(x, raiz); }
+    
+    // Algoritmo en base al libro de Thomas H. Cormen. Devuelve true si la
+    // raíz r era roja y se pintó de negro (la altura negra creció en uno)
+    bool ajustarInsercion(nodo* z, nodo*& r) {
+        ARBOL_INICIAR_PASOS();
         while (z->padre->color == ROJO) {
+            ARBOL_CONTAR_PASO();
             if (z->padre == z->padre->padre->izq) {
                 nodo* y = z->padre->padre->der;
                 if (y->color == ROJO) {
+                    ARBOL_REGISTRAR_CASO(INSERCION_TIO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(3);
                     z->padre->color = NEGRO;
                     y->color = NEGRO;
                     z->padre->padre->color = ROJO;
                     z = z->padre->padre;
                 } else {
                     if (z == z->padre->der) {
+                        ARBOL_REGISTRAR_CASO(INSERCION_TRIANGULO);
                         z = z->padre;
-                        rotarIzquierda(z);
+                        rotarIzquierda(z, r);
                     }
+                    ARBOL_REGISTRAR_CASO(INSERCION_LINEA);
+                    ARBOL_REGISTRAR_RECOLOREO(2);
                     z->padre->color = NEGRO;
                     z->padre->padre->color = ROJO;
-                    rotarDerecha(z->padre->padre);
+                    rotarDerecha(z->padre->padre, r);
                 }
             } else {
                 nodo* y = z->padre->padre->izq;
                 if (y->color == ROJO) {
+                    ARBOL_REGISTRAR_CASO(INSERCION_TIO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(3);
                     z->padre->color = NEGRO;
                     y->color = NEGRO;
                     z->padre->padre->color = ROJO;
                     z = z->padre->padre;
                 } else {
                     if (z == z->padre->izq) {
+                        ARBOL_REGISTRAR_CASO(INSERCION_TRIANGULO);
                         z = z->padre;
-                        rotarDerecha(z);
+                        rotarDerecha(z, r);
                     }
+                    ARBOL_REGISTRAR_CASO(INSERCION_LINEA);
+                    ARBOL_REGISTRAR_RECOLOREO(2);
                     z->padre->color = NEGRO;
                     z->padre->padre->color = ROJO;
-                    rotarIzquierda(z->padre->padre);
+                    rotarIzquierda(z->padre->padre, r);
                 }
             }
         }
-        raiz->color = NEGRO;
+        ARBOL_REGISTRAR_AJUSTE(AJUSTE_INSERCION);
+        bool crecio = r->color == ROJO;
+        ARBOL_REGISTRAR_RECOLOREO(crecio ? 1 : 0);
+        r->color = NEGRO;
+        return crecio;
     }
     
+    void ajustarInsercion(nodo* z) { ajustarInsercion(z, raiz); }
+    
     // Función aux del transplante de u,v para el balanceo del Árbol RojiNegro
     void transplantar(nodo* u, nodo* v) {
         if (u->padre == NIL)
@@ -145,25 +614,35 @@ private:
     
     // Eliminación de nodo x por medio de los 4 casos de Thomas H. Cormen
     void ajustarEliminacion(nodo* x) {
+        ARBOL_INICIAR_PASOS();
         while (x != raiz && x->color == NEGRO) {
+            ARBOL_CONTAR_PASO();
             if (x == x->padre->izq) {
                 nodo* w = x->padre->der;
                 if (w->color == ROJO) {
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_HERMANO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(2);
                     w->color = NEGRO;
                     x->padre->color = ROJO;
                     rotarIzquierda(x->padre);
                     w = x->padre->der;
                 }
                 if (w->izq->color == NEGRO && w->der->color == NEGRO) {
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINOS_NEGROS);
+                    ARBOL_REGISTRAR_RECOLOREO(1);
                     w->color = ROJO;
                     x = x->padre;
                 } else {
                     if (w->der->color == NEGRO) {
+                        ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINO_LEJANO_NEGRO);
+                        ARBOL_REGISTRAR_RECOLOREO(2);
                         w->izq->color = NEGRO;
                         w->color = ROJO;
                         rotarDerecha(w);
                         w = x->padre->der;
                     }
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINO_LEJANO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(3);
                     w->color = x->padre->color;
                     x->padre->color = NEGRO;
                     w->der->color = NEGRO;
@@ -173,21 +652,29 @@ private:
             } else {
                 nodo* w = x->padre->izq;
                 if (w->color == ROJO) {
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_HERMANO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(2);
                     w->color = NEGRO;
                     x->padre->color = ROJO;
                     rotarDerecha(x->padre);
                     w = x->padre->izq;
                 }
                 if (w->der->color == NEGRO && w->izq->color == NEGRO) {
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINOS_NEGROS);
+                    ARBOL_REGISTRAR_RECOLOREO(1);
                     w->color = ROJO;
                     x = x->padre;
                 } else {
                     if (w->izq->color == NEGRO) {
+                        ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINO_LEJANO_NEGRO);
+                        ARBOL_REGISTRAR_RECOLOREO(2);
                         w->der->color = NEGRO;
                         w->color = ROJO;
                         rotarIzquierda(w);
                         w = x->padre->izq;
                     }
+                    ARBOL_REGISTRAR_CASO(ELIMINACION_SOBRINO_LEJANO_ROJO);
+                    ARBOL_REGISTRAR_RECOLOREO(3);
                     w->color = x->padre->color;
                     x->padre->color = NEGRO;
                     w->izq->color = NEGRO;
@@ -196,81 +683,81 @@ private:
                 }
             }
         }
+        ARBOL_REGISTRAR_AJUSTE(AJUSTE_ELIMINACION);
+        ARBOL_REGISTRAR_RECOLOREO(x->color == ROJO ? 1 : 0);
         x->color = NEGRO;
     }
     
-    // Eliminar el árbol
+    // Eliminar el árbol (solo destruye los nodos; la memoria es de los bloques)
     void destruirArbol(nodo* n) {
         if (n != NIL) {
             destruirArbol(n->izq);
             destruirArbol(n->der);
-            delete n;
+            ARBOL_REGISTRAR_LIBERACION();
+            destruirNodo(n);
         }
     }
-
-public:
-	// Constructor
-    ArbolRojiNegro() {
-        NIL = new nodo;
-        NIL->color = NEGRO;
-        NIL->izq = NIL->der = NIL->padre = 	nullptr;
-        raiz = NIL;
-    }
     
-    // Destructor
-    ~ArbolRojiNegro() {
-        destruirArbol(raiz);
-        delete NIL;
+    void liberarBloques() {
+        for (size_t i = 0; i < bloques.size(); i++)
+            ::operator delete(bloques[i]);
+        bloques.clear();
+        bloqueActual = libres = nullptr;
+        usadosBloque = capacidadBloque = 0;
     }
     
-    // Inserción llamando a ajustarInserción(z) (z: el nuevo nodo)
-    void insertar(int clave, string info) {
-        nodo* z = new nodo;
-        z->clave = clave;
-        z->Info = info;
-        z->izq = NIL;
-        z->der = NIL;
-        z->color = ROJO;
+    // Enlaza z (ya creado) bajo su padre y y rebalancea
+    void enlazarInsercion(nodo* z, nodo* y, bool aLaIzquierda) {
+        descongelar();
+        z->padre = y;
+        if (y == NIL)
+            raiz = z;
+        else if (aLaIzquierda)
+            y->izq = z;
+        else
+            y->der = z;
         
+        actualizarCamino(y); // un nodo más en cada subárbol del camino
+        ajustarInsercion(z);
+    }
+    
+    nodo* insertarNodo(nodo* z) {
         nodo* y = NIL;
         nodo* x = raiz;
         
+        ARBOL_INICIAR_PASOS();
         while (x != NIL) {
+            ARBOL_CONTAR_PASO();
             y = x;
-            if (z->clave < x->clave)
+            if (comp(z->clave, x->clave))
                 x = x->izq;
             else
                 x = x->der;
         }
+        ARBOL_REGISTRAR_DESCENSO(DESCENSO_INSERCION);
         
-        z->padre = y;
-        
-        if (y == NIL)
-            raiz = z;
-        else if (z->clave < y->clave)
-            y->izq = z;
-        else
-            y->der = z;
-        
-        ajustarInsercion(z);
+        enlazarInsercion(z, y, y != NIL && comp(z->clave, y->clave));
+        return z;
     }
     
-    // Eliminación a través de la clave
-    bool eliminar(int clave) {
-        nodo* z = buscarNodo(clave);
-        if (z == NIL)
-            return false;
+    // Elimina el nodo z con los 4 casos de Cormen. Los demás nodos no se
+    // mueven de lugar en memoria: sus iteradores siguen siendo válidos
+    void eliminarNodo(nodo* z) {
+        descongelar();
         
         nodo* y = z;
         nodo* x;
+        nodo* desde; // nodo más profundo cuyo subárbol perdió un nodo
         bool colorOriginalY = y->color;
         
         if (z->izq == NIL) {
             x = z->der;
             transplantar(z, z->der);
+            desde = z->padre;
         } else if (z->der == NIL) {
             x = z->izq;
             transplantar(z, z->izq);
+            desde = z->padre;
         } else {
             y = minimo(z->der);
             colorOriginalY = y->color;
@@ -278,7 +765,9 @@ public:
             
             if (y->padre == z) {
                 x->padre = y;
+                desde = y;
             } else {
+                desde = y->padre;
                 transplantar(y, y->der);
                 y->der = z->der;
                 y->der->padre = y;
@@ -290,34 +779,1328 @@ public:
             y->color = z->color;
         }
         
-        delete z;
+        liberarNodo(z);
         
+        actualizarCamino(desde); // antes del ajuste: las rotaciones usan los tamaños de los hijos
         if (colorOriginalY == NEGRO)
             ajustarEliminacion(x);
+    }
+    
+    // Inserta z justo después de pista si su clave cabe entre pista y el
+    // sucesor de pista; si no, hace la inserción normal desde la raíz. Con
+    // claves que llegan en orden la posición se encuentra sin descender
+    nodo* insertarConPista(nodo* pista, nodo* z) {
+        if (pista != NIL && !comp(z->clave, pista->clave)) {
+            nodo* s = sucesor(pista);
+            if (s == NIL || !comp(s->clave, z->clave)) {
+                // pista <= z <= s: z va en el hueco derecho de pista o en el
+                // izquierdo de s (uno de los dos siempre está libre)
+                if (pista->der == NIL)
+                    enlazarInsercion(z, pista, false);
+                else
+                    enlazarInsercion(z, s, true);
+                return z;
+            }
+        }
+        return insertarNodo(z);
+    }
+    
+    // Arma un subárbol perfectamente balanceado con los n primeros nodos de
+    // la cadena (enlazada por der, en inorden) y avanza la cadena. Los nodos
+    // a profundidad profRoja quedan rojos y el resto negros
+    nodo* construirBalanceado(nodo*& cadena, size_t n, size_t prof, size_t profRoja) {
+        if (n == 0) return NIL;
+        size_t nIzq = (n - 1) / 2;
+        nodo* izq = construirBalanceado(cadena, nIzq, prof + 1, profRoja);
+        nodo* r = cadena;
+        cadena = cadena->der; // se lee antes de sobrescribir r->der
+        r->izq = izq;
+        if (izq != NIL) izq->padre = r;
+        r->der = construirBalanceado(cadena, n - nIzq - 1, prof + 1, profRoja);
+        if (r->der != NIL) r->der->padre = r;
+        r->color = prof == profRoja ? ROJO : NEGRO;
+        actualizar(r);
+        return r;
+    }
+    
+    // Convierte una cadena de n nodos en inorden en el árbol completo
+    void construirDesdeCadena(nodo* cadena, size_t n) {
+        descongelar();
+        // Con mitades que difieren en a lo sumo uno, todos los NIL quedan a
+        // profundidad d o d + 1. Si el último nivel (d) está incompleto se
+        // pinta de rojo: así todo camino a un NIL cruza d nodos negros
+        size_t d = 0;
+        while (((size_t)2 << d) - 1 < n) d++;
+        size_t profRoja = ((size_t)2 << d) - 1 == n ? (size_t)-1 : d;
+        raiz = construirBalanceado(cadena, n, 0, profRoja);
+        raiz->padre = NIL;
+    }
+    
+    // Unir y dividir
+    //
+    // Un Subarbol es una raíz suelta (padre = NIL) con su altura negra: los
+    // nodos negros de cualquier camino de r a un NIL, contando r y sin
+    // contar el NIL. Los hijos de r tienen altura bh - 1 si r es negro y bh
+    // si es rojo, así que la altura se arrastra en la recursión sin recorrer
+    // el árbol. Estas funciones solo escriben en nodos del propio subárbol
+    // (nunca en NIL), de modo que dos ramas de la recursión pueden correr en
+    // hilos distintos.
+    struct Subarbol {
+        nodo* r;
+        int bh;
+    };
+    
+    // Por debajo de este tamaño las dos ramas corren en el mismo hilo
+    static const size_t UMBRAL_PARALELO = 4096;
+    
+    Subarbol subarbol(nodo* r, int bh) {
+        if (r != NIL) r->padre = NIL;
+        Subarbol t = { r, bh };
+        return t;
+    }
+    
+    int alturaNegra(nodo* r) const {
+        int bh = 0;
+        for (; r != NIL; r = r->izq)
+            if (r->color == NEGRO) bh++;
+        return bh;
+    }
+    
+    // Raíz roja -> negra (sigue siendo válido, con un nivel negro más)
+    static void ennegrecer(Subarbol& t) {
+        if (t.r->color == ROJO) {
+            t.r->color = NEGRO;
+            t.bh++;
+        }
+    }
+    
+    // Árbol con las claves de a, luego k, luego las de b (a <= k <= b).
+    // O(|bh(a) - bh(b)| + 1): k baja por el borde del más alto hasta un nodo
+    // negro de la altura del otro, se cuelga ahí en rojo y se ajusta como
+    // una inserción
+    Subarbol juntar(Subarbol a, nodo* k, Subarbol b) {
+        if (a.r != NIL) ennegrecer(a);
+        if (b.r != NIL) ennegrecer(b);
+        if (a.bh == b.bh) {
+            k->color = NEGRO;
+            k->izq = a.r;
+            k->der = b.r;
+            k->padre = NIL;
+            if (a.r != NIL) a.r->padre = k;
+            if (b.r != NIL) b.r->padre = k;
+            actualizar(k);
+            Subarbol t = { k, a.bh + 1 };
+            return t;
+        }
+        
+        bool porDerecha = a.bh > b.bh; // k baja por el borde derecho de a
+        Subarbol alto = porDerecha ? a : b;
+        nodo* bajo = porDerecha ? b.r : a.r;
+        int bhBajo = porDerecha ? b.bh : a.bh;
+        
+        nodo* p = NIL;
+        nodo* c = alto.r;
+        int h = alto.bh;
+        while (c->color == ROJO || h != bhBajo) { // NIL es negro de altura 0
+            if (c->color == NEGRO) h--;
+            p = c;
+            c = porDerecha ? c->der : c->izq;
+        }
+        
+        k->color = ROJO;
+        k->padre = p;
+        if (porDerecha) {
+            k->izq = c;
+            k->der = bajo;
+            p->der = k;
+        } else {
+            k->izq = bajo;
+            k->der = c;
+            p->izq = k;
+        }
+        if (c != NIL) c->padre = k;
+        if (bajo != NIL) bajo->padre = k;
+        actualizar(k);
+        actualizarCamino(p);
+        
+        nodo* r = alto.r;
+        bool crecio = ajustarInsercion(k, r);
+        Subarbol t = { r, alto.bh + (crecio ? 1 : 0) };
+        return t;
+    }
+    
+    // Saca el mínimo de t (queda suelto en m) y devuelve el resto
+    Subarbol separarMinimo(Subarbol t, nodo*& m) {
+        nodo* n = t.r;
+        int bhHijos = t.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol izq = subarbol(n->izq, bhHijos);
+        Subarbol der = subarbol(n->der, bhHijos);
+        if (izq.r == NIL) {
+            m = n;
+            return der;
+        }
+        return juntar(separarMinimo(izq, m), n, der);
+    }
+    
+    // Juntar sin clave en medio (a <= b)
+    Subarbol juntar2(Subarbol a, Subarbol b) {
+        if (a.r == NIL) return b;
+        if (b.r == NIL) return a;
+        nodo* m;
+        Subarbol resto = separarMinimo(b, m);
+        return juntar(a, m, resto);
+    }
+    
+    // Reparte t en menores (< k) y mayores (> k). Los iguales a k van a
+    // mayores si iguales es nullptr, o se apartan sueltos en *iguales, en
+    // inorden. O(log n): baja por un camino juntando lo que queda a cada lado
+    void dividir(Subarbol t, const Clave& k, Subarbol& menores, Subarbol& mayores, vector<nodo*>* iguales) {
+        if (t.r == NIL) {
+            menores = mayores = t;
+            return;
+        }
+        nodo* n = t.r;
+        int bhHijos = t.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol izq = subarbol(n->izq, bhHijos);
+        Subarbol der = subarbol(n->der, bhHijos);
+        Subarbol medio;
+        
+        if (comp(n->clave, k)) {
+            dividir(der, k, medio, mayores, iguales);
+            menores = juntar(izq, n, medio);
+        } else if (comp(k, n->clave) || iguales == nullptr) {
+            dividir(izq, k, menores, medio, iguales);
+            mayores = juntar(medio, n, der);
+        } else {
+            // n == k: puede haber más iguales a ambos lados
+            Subarbol vacio;
+            dividir(izq, k, menores, vacio, iguales);
+            iguales->push_back(n);
+            dividir(der, k, vacio, mayores, iguales);
+        }
+    }
+    
+    // Reparte t en hasta (<= k) y mayores (> k), como dividir con los
+    // iguales del lado de los menores
+    void dividirDespues(Subarbol t, const Clave& k, Subarbol& hasta, Subarbol& mayores) {
+        if (t.r == NIL) {
+            hasta = mayores = t;
+            return;
+        }
+        nodo* n = t.r;
+        int bhHijos = t.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol izq = subarbol(n->izq, bhHijos);
+        Subarbol der = subarbol(n->der, bhHijos);
+        Subarbol medio;
+        
+        if (comp(k, n->clave)) {
+            dividirDespues(izq, k, hasta, medio);
+            mayores = juntar(medio, n, der);
+        } else {
+            dividirDespues(der, k, medio, mayores);
+            hasta = juntar(izq, n, medio);
+        }
+    }
+    
+    // Devuelve al pool todos los nodos del subárbol de n
+    void liberarSubarbol(nodo* n) {
+        if (n != NIL) {
+            liberarSubarbol(n->izq);
+            liberarSubarbol(n->der);
+            liberarNodo(n);
+        }
+    }
+    
+    // Recorre en inorden el subárbol de n: libera los nodos que cumplen
+    // pred y encadena los demás por der detrás de cola. Los hijos se leen
+    // antes de tocar n, así que reescribir los enlaces no estorba
+    template <class Pred>
+    void filtrar(nodo* n, Pred& pred, nodo*& cabeza, nodo*& cola, size_t& quedan) {
+        if (n == NIL) return;
+        nodo* der = n->der;
+        filtrar(n->izq, pred, cabeza, cola, quedan);
+        if (pred(n->clave, n->Info)) {
+            liberarNodo(n);
+        } else {
+            n->izq = n->padre = NIL;
+            if (cola == NIL)
+                cabeza = n;
+            else
+                cola->der = n;
+            cola = n;
+            quedan++;
+        }
+        filtrar(der, pred, cabeza, cola, quedan);
+    }
+    
+    // Corre las dos ramas con el ejecutor si el trabajo lo justifica. Cada
+    // rama aparta sus nodos sobrantes en su propio vector
+    template <class Ejecutor, class F1, class F2>
+    void ramas(Ejecutor& ejecutor, size_t trabajo, vector<nodo*>& sobrantes, F1 f1, F2 f2) {
+        if (trabajo < UMBRAL_PARALELO) {
+            f1(sobrantes);
+            f2(sobrantes);
+            return;
+        }
+        vector<nodo*> sobrantesDer;
+        ejecutor.dividir([&]() { f1(sobrantes); }, [&]() { f2(sobrantesDer); });
+        sobrantes.insert(sobrantes.end(), sobrantesDer.begin(), sobrantesDer.end());
+    }
+    
+    void apartarTodos(nodo* n, vector<nodo*>& sobrantes) {
+        if (n != NIL) {
+            apartarTodos(n->izq, sobrantes);
+            apartarTodos(n->der, sobrantes);
+            sobrantes.push_back(n);
+        }
+    }
+    
+    // a con los nodos de b. Si reemplazar, cada clave de b descarta las
+    // iguales de a; si no, se conservan todas como al insertar una a una:
+    // a se divide con los iguales del lado de los menores, así que las
+    // repetidas de a quedan antes que las de b
+    template <class Ejecutor>
+    Subarbol unirRec(Subarbol a, Subarbol b, bool reemplazar, vector<nodo*>& sobrantes, Ejecutor& ejecutor) {
+        if (b.r == NIL) return a;
+        if (a.r == NIL) return b;
+        size_t trabajo = a.r->tam + b.r->tam;
+        nodo* n = b.r;
+        int bhHijos = b.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol bIzq = subarbol(n->izq, bhHijos);
+        Subarbol bDer = subarbol(n->der, bhHijos);
+        Subarbol aMen, aMay, izq, der;
+        if (reemplazar)
+            dividir(a, n->clave, aMen, aMay, &sobrantes);
+        else
+            dividirDespues(a, n->clave, aMen, aMay);
+        ramas(ejecutor, trabajo, sobrantes,
+              [&](vector<nodo*>& s) { izq = unirRec(aMen, bIzq, reemplazar, s, ejecutor); },
+              [&](vector<nodo*>& s) { der = unirRec(aMay, bDer, reemplazar, s, ejecutor); });
+        return juntar(izq, n, der);
+    }
+    
+    // Los nodos de a cuya clave está en b
+    template <class Ejecutor>
+    Subarbol interseccionRec(Subarbol a, Subarbol b, vector<nodo*>& sobrantes, Ejecutor& ejecutor) {
+        if (a.r == NIL || b.r == NIL) {
+            apartarTodos(a.r, sobrantes);
+            apartarTodos(b.r, sobrantes);
+            return subarbol(NIL, 0);
+        }
+        size_t trabajo = a.r->tam + b.r->tam;
+        nodo* n = b.r;
+        int bhHijos = b.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol bIzq = subarbol(n->izq, bhHijos);
+        Subarbol bDer = subarbol(n->der, bhHijos);
+        Subarbol aMen, aMay, izq, der;
+        vector<nodo*> iguales;
+        dividir(a, n->clave, aMen, aMay, &iguales);
+        ramas(ejecutor, trabajo, sobrantes,
+              [&](vector<nodo*>& s) { izq = interseccionRec(aMen, bIzq, s, ejecutor); },
+              [&](vector<nodo*>& s) { der = interseccionRec(aMay, bDer, s, ejecutor); });
+        sobrantes.push_back(n);
+        if (iguales.empty()) return juntar2(izq, der);
+        for (size_t i = 0; i + 1 < iguales.size(); i++)
+            izq = juntar(izq, iguales[i], subarbol(NIL, 0));
+        return juntar(izq, iguales.back(), der);
+    }
+    
+    // Los nodos de a cuya clave no está en b
+    template <class Ejecutor>
+    Subarbol diferenciaRec(Subarbol a, Subarbol b, vector<nodo*>& sobrantes, Ejecutor& ejecutor) {
+        if (a.r == NIL || b.r == NIL) {
+            apartarTodos(b.r, sobrantes);
+            return a;
+        }
+        size_t trabajo = a.r->tam + b.r->tam;
+        nodo* n = b.r;
+        int bhHijos = b.bh - (n->color == NEGRO ? 1 : 0);
+        Subarbol bIzq = subarbol(n->izq, bhHijos);
+        Subarbol bDer = subarbol(n->der, bhHijos);
+        Subarbol aMen, aMay, izq, der;
+        dividir(a, n->clave, aMen, aMay, &sobrantes);
+        ramas(ejecutor, trabajo, sobrantes,
+              [&](vector<nodo*>& s) { izq = diferenciaRec(aMen, bIzq, s, ejecutor); },
+              [&](vector<nodo*>& s) { der = diferenciaRec(aMay, bDer, s, ejecutor); });
+        sobrantes.push_back(n);
+        return juntar2(izq, der);
+    }
+    
+    // Cambia el centinela viejo por nuevo en los enlaces del árbol de raíz r
+    void cambiarNIL(nodo*& r, nodo* viejo, nodo* nuevo) {
+        if (r == viejo) {
+            r = nuevo;
+            return;
+        }
+        r->padre = nuevo;
+        cambiarNILHijos(r, viejo, nuevo);
+    }
+    
+    void cambiarNILHijos(nodo* n, nodo* viejo, nodo* nuevo) {
+        if (n->izq == viejo) n->izq = nuevo; else cambiarNILHijos(n->izq, viejo, nuevo);
+        if (n->der == viejo) n->der = nuevo; else cambiarNILHijos(n->der, viejo, nuevo);
+    }
+    
+    // Se queda con los nodos y los bloques de otro, que queda vacío. Los dos
+    // centinelas son iguales, así que se reescriben los enlaces del árbol
+    // más chico y, si ese es este, se intercambian los NIL
+    Subarbol adoptar(ArbolRojiNegro& otro) {
+        descongelar();
+        otro.descongelar();
+        nodo* r = otro.raiz;
+        if (r->tam > raiz->tam) {
+            cambiarNIL(raiz, NIL, otro.NIL);
+            swap(NIL, otro.NIL);
+        } else {
+            cambiarNIL(r, otro.NIL, NIL);
+        }
+        bloques.insert(bloques.end(), otro.bloques.begin(), otro.bloques.end());
+        while (otro.libres != nullptr) {
+            nodo* n = otro.libres;
+            otro.libres = n->izq;
+            n->izq = libres;
+            libres = n;
+        }
+        otro.bloques.clear();
+        otro.bloqueActual = nullptr;
+        otro.usadosBloque = otro.capacidadBloque = 0;
+        otro.raiz = otro.NIL;
+        return subarbol(r, alturaNegra(r));
+    }
+    
+    void fijarRaiz(Subarbol t, vector<nodo*>& sobrantes) {
+        raiz = t.r;
+        if (raiz != NIL) {
+            raiz->padre = NIL;
+            raiz->color = NEGRO;
+        }
+        for (size_t i = 0; i < sobrantes.size(); i++)
+            liberarNodo(sobrantes[i]);
+    }
+
+    // Deja en error la falla y la posición en inorden del nodo
+    static int fallar(string& error, const char* motivo, size_t posicion) {
+        error = string(motivo) + " (posición " + to_string(posicion) + " en inorden)";
+        return -1;
+    }
+    
+    // Revisa el subárbol de n (hijo de padre, con claves entre menor y mayor
+    // si no son NIL) y devuelve su altura negra, o -1 con la primera falla
+    // en error. base es la posición en inorden de la primera clave de n
+    int verificarRec(const nodo* n, const nodo* padre, const nodo* menor, const nodo* mayor, size_t base,
+                     string& error) const {
+        if (n == NIL) return 0;
+        size_t posicion = base + n->izq->tam;
+        if (n->padre != padre)
+            return fallar(error, "enlace al padre roto", posicion);
+        if ((menor != NIL && comp(n->clave, menor->clave)) || (mayor != NIL && comp(mayor->clave, n->clave)))
+            return fallar(error, "clave fuera de orden", posicion);
+        if (n->color == ROJO && (n->izq->color == ROJO || n->der->color == ROJO))
+            return fallar(error, "nodo rojo con hijo rojo", posicion);
+        if (n->tam != n->izq->tam + n->der->tam + 1)
+            return fallar(error, "tamaño de subárbol incorrecto", posicion);
+        int izq = verificarRec(n->izq, n, menor, n, base, error);
+        if (izq < 0) return -1;
+        int der = verificarRec(n->der, n, n, mayor, posicion + 1, error);
+        if (der < 0) return -1;
+        if (izq != der)
+            return fallar(error, "alturas negras distintas bajo el nodo", posicion);
+        return izq + (n->color == NEGRO ? 1 : 0);
+    }
+
+public:
+	// Constructor
+    explicit ArbolRojiNegro(const Comparar& comparar = Comparar()) : comp(comparar), congelado(false) {
+        bloqueActual = libres = nullptr;
+        usadosBloque = capacidadBloque = 0;
+        NIL = new nodo;
+        NIL->color = NEGRO;
+        NIL->tam = 0;
+        fijarNeutro(NIL, hayAgregado());
+        NIL->izq = NIL->der = NIL->padre = 	nullptr;
+        raiz = NIL;
+    }
+    
+    // Destructor
+    ~ArbolRojiNegro() {
+        destruirArbol(raiz);
+        liberarBloques();
+        delete NIL;
+    }
+    
+    // Elimina todas las claves y devuelve la memoria de los nodos
+    void vaciar() {
+        descongelar();
+        destruirArbol(raiz);
+        liberarBloques();
+        raiz = NIL;
+    }
+    
+    // Inserción llamando a ajustarInserción(z) (z: el nuevo nodo)
+    void insertar(const Clave& clave, const Valor& info) {
+        insertarNodo(crearNodo(clave, info));
+    }
+    
+    // Igual, moviendo la información al nodo en vez de copiarla
+    void insertar(const Clave& clave, Valor&& info) {
+        insertarNodo(crearNodo(clave, move(info)));
+    }
+    
+    // Carga en O(n) una secuencia ordenada de pares (clave, información),
+    // por ejemplo un vector<pair<Clave, Valor> > o un map. Si el árbol está
+    // vacío y la entrada viene ordenada, todos los nodos se reservan en un
+    // solo bloque y se arma directamente un árbol balanceado. Si no, cada
+    // par se inserta con el anterior como pista: una entrada casi ordenada
+    // sigue siendo barata y una desordenada da el mismo árbol que insertar
+    template <class Iterador>
+    void construirDesdeOrdenado(Iterador primero, Iterador ultimo) {
+        size_t n = 0;
+        bool ordenado = true;
+        for (Iterador it = primero, ant = primero; it != ultimo; ant = it, ++it, n++) {
+            if (n > 0 && comp(it->first, ant->first)) {
+                ordenado = false;
+                break;
+            }
+        }
         
+        if (raiz != NIL || !ordenado) {
+            nodo* pista = NIL;
+            for (; primero != ultimo; ++primero)
+                pista = insertarConPista(pista, crearNodo(primero->first, primero->second));
+            return;
+        }
+        if (n == 0) return;
+        
+        // Un bloque de exactamente n nodos, encadenados en orden por der. Si
+        // algo lanza, se destruyen los nodos ya construidos y se devuelve el
+        // bloque: el árbol sigue vacío
+        nodo* bloque = nuevoBloque(n);
+        size_t construidos = 0;
+        try {
+            for (; primero != ultimo; ++primero, construidos++) {
+                nodo* z = &bloque[construidos];
+                construirNodo(z, primero->first, primero->second);
+                z->izq = z->padre = NIL;
+                z->der = construidos + 1 < n ? &bloque[construidos + 1] : NIL;
+            }
+            construirDesdeCadena(bloque, n);
+        } catch (...) {
+            for (size_t i = 0; i < construidos; i++) destruirNodo(&bloque[i]);
+            bloques.pop_back();
+            ::operator delete(bloque);
+            raiz = NIL;
+            throw;
+        }
+        ARBOL_REGISTRAR_RESERVAS(n);
+    }
+    
+    // Operaciones de conjuntos sobre unir/dividir. Todas consumen otro: sus
+    // nodos pasan a este árbol (o se liberan) y otro queda vacío. Con m el
+    // tamaño del árbol más chico y n el del más grande el trabajo es
+    // O(m log(n/m + 1)); con un PoolHilos las dos mitades de cada paso
+    // corren en paralelo. Invalidan los iteradores de ambos árboles
+    //
+    // unir: agrega las claves de otro. Una clave que está en los dos queda
+    //       con las entradas de otro (las de este árbol se descartan)
+    template <class Ejecutor>
+    void unir(ArbolRojiNegro& otro, Ejecutor& ejecutor) {
+        if (&otro == this) return;
+        Subarbol b = adoptar(otro);
+        vector<nodo*> sobrantes;
+        fijarRaiz(unirRec(subarbol(raiz, alturaNegra(raiz)), b, true, sobrantes, ejecutor), sobrantes);
+    }
+    
+    void unir(ArbolRojiNegro& otro) {
+        EjecucionSecuencial secuencial;
+        unir(otro, secuencial);
+    }
+    
+    // Deja solo las claves que también están en otro
+    template <class Ejecutor>
+    void interseccion(ArbolRojiNegro& otro, Ejecutor& ejecutor) {
+        if (&otro == this) return;
+        Subarbol b = adoptar(otro);
+        vector<nodo*> sobrantes;
+        fijarRaiz(interseccionRec(subarbol(raiz, alturaNegra(raiz)), b, sobrantes, ejecutor), sobrantes);
+    }
+    
+    void interseccion(ArbolRojiNegro& otro) {
+        EjecucionSecuencial secuencial;
+        interseccion(otro, secuencial);
+    }
+    
+    // Quita las claves que están en otro
+    template <class Ejecutor>
+    void diferencia(ArbolRojiNegro& otro, Ejecutor& ejecutor) {
+        if (&otro == this) {
+            vaciar();
+            return;
+        }
+        Subarbol b = adoptar(otro);
+        vector<nodo*> sobrantes;
+        fijarRaiz(diferenciaRec(subarbol(raiz, alturaNegra(raiz)), b, sobrantes, ejecutor), sobrantes);
+    }
+    
+    void diferencia(ArbolRojiNegro& otro) {
+        EjecucionSecuencial secuencial;
+        diferencia(otro, secuencial);
+    }
+    
+    // Inserta todos los pares del lote, con el mismo resultado que llamar a
+    // insertar con cada uno: las claves repetidas se conservan y quedan
+    // después de las iguales que ya estaban, en el orden del lote. Ordena
+    // el lote (de forma estable), lo carga en O(m) en un árbol aparte y lo
+    // une con este
+    template <class Ejecutor>
+    void insertarLote(const vector<pair<Clave, Valor> >& lote, Ejecutor& ejecutor) {
+        vector<pair<Clave, Valor> > ordenado(lote);
+        Comparar c = comp;
+        stable_sort(ordenado.begin(), ordenado.end(),
+                    [&c](const pair<Clave, Valor>& a, const pair<Clave, Valor>& b) { return c(a.first, b.first); });
+        ArbolRojiNegro otro(comp);
+        otro.construirDesdeOrdenado(ordenado.begin(), ordenado.end());
+        Subarbol b = adoptar(otro);
+        vector<nodo*> sobrantes;
+        fijarRaiz(unirRec(subarbol(raiz, alturaNegra(raiz)), b, false, sobrantes, ejecutor), sobrantes);
+    }
+    
+    void insertarLote(const vector<pair<Clave, Valor> >& lote) {
+        EjecucionSecuencial secuencial;
+        insertarLote(lote, secuencial);
+    }
+    
+    // Eliminación a través de la clave
+    bool eliminar(const Clave& clave) {
+        nodo* z = buscarNodo(clave);
+        if (z == NIL)
+            return false;
+        eliminarNodo(z);
         return true;
     }
     
-    // Buscar la clave
-    string buscar(int clave) {
+    // Elimina todas las claves en [a, b] y devuelve cuántas eran. En
+    // O(log n + k): dos divisiones dejan el intervalo en un subárbol suelto,
+    // que se libera entero sin rebalancear, y un juntar une los dos lados
+    size_t eliminarRango(const Clave& a, const Clave& b) {
+        size_t k = contar(a, b);
+        if (k == 0) return 0;
+        descongelar();
+        Subarbol menores, resto, medio, mayores;
+        dividir(subarbol(raiz, alturaNegra(raiz)), a, menores, resto, nullptr);
+        dividirDespues(resto, b, medio, mayores);
+        liberarSubarbol(medio.r);
+        vector<nodo*> sobrantes;
+        fijarRaiz(juntar2(menores, mayores), sobrantes);
+        return k;
+    }
+    
+    // Elimina todas las claves menores que limite (vencimiento por marca de
+    // agua) y devuelve cuántas eran, también en O(log n + k)
+    size_t eliminarMenores(const Clave& limite) {
+        size_t k = rank(limite);
+        if (k == 0) return 0;
+        descongelar();
+        Subarbol menores, resto;
+        dividir(subarbol(raiz, alturaNegra(raiz)), limite, menores, resto, nullptr);
+        liberarSubarbol(menores.r);
+        vector<nodo*> sobrantes;
+        fijarRaiz(resto, sobrantes);
+        return k;
+    }
+    
+    // Elimina las claves para las que pred(clave, info) es verdadero y
+    // devuelve cuántas eran. Un solo recorrido en inorden libera las que
+    // salen y encadena las que quedan; después el árbol se rearma
+    // balanceado en O(n) (construirDesdeCadena) en lugar de rebalancear
+    // una vez por clave. Los nodos que quedan no se mueven: sus iteradores
+    // siguen valiendo. pred no debe lanzar excepciones ni tocar el árbol
+    template <class Pred>
+    size_t eliminarSi(Pred pred) {
+        size_t antes = getTam();
+        if (antes == 0) return 0;
+        descongelar();
+        nodo* cabeza = NIL;
+        nodo* cola = NIL;
+        size_t quedan = 0;
+        filtrar(raiz, pred, cabeza, cola, quedan);
+        raiz = NIL;
+        if (quedan > 0) construirDesdeCadena(cabeza, quedan);
+        return antes - quedan;
+    }
+    
+    // Buscar la clave: apunta a su información sin copiarla, o nullptr si
+    // no está. El puntero vale hasta que se elimine la clave o se modifique
+    // el árbol (congelar y descongelar mueven la información)
+    const Valor* buscar(const Clave& clave) const {
+        if (congelado)
+            return buscarCongelado(clave);
         nodo* n = buscarNodo(clave);
         if (n != NIL)
-            return n->Info;
-        return "";
+            return &n->Info;
+        return nullptr;
+    }
+    
+    // Búsqueda heterogénea: solo con un comparador transparente
+    template <class K, class C = Comparar, class = typename C::is_transparent>
+    const Valor* buscar(const K& clave) const {
+        if (congelado)
+            return buscarCongelado(clave);
+        nodo* n = buscarNodo(clave);
+        if (n != NIL)
+            return &n->Info;
+        return nullptr;
+    }
+    
+    // Búsqueda por lotes: resultados[i] apunta a la información de claves[i]
+    // (nullptr si no está). En lugar de terminar un descenso antes de empezar
+    // el siguiente, lleva DESCENSOS_EN_VUELO a la vez y los avanza un nivel
+    // por turno, precargando el hijo al que va cada uno: cuando vuelve a
+    // tocarle, su nodo ya suele estar en caché y los fallos se solapan
+    static const int DESCENSOS_EN_VUELO = 16;
+    
+    void buscarLote(const Clave* claves, size_t n, const Valor** resultados) const {
+        if (congelado) {
+            for (size_t i = 0; i < n; i++) resultados[i] = buscarCongelado(claves[i]);
+            return;
+        }
+        nodo* actual[DESCENSOS_EN_VUELO];
+        size_t indice[DESCENSOS_EN_VUELO];
+        size_t siguiente = 0;
+        int activos = 0;
+        while (activos < DESCENSOS_EN_VUELO && siguiente < n) {
+            indice[activos] = siguiente++;
+            actual[activos++] = raiz;
+        }
+        
+        while (activos > 0) {
+            for (int i = 0; i < activos; ) {
+                nodo* x = actual[i];
+                const Clave& clave = claves[indice[i]];
+                if (x != NIL) {
+                    if (comp(clave, x->clave))
+                        x = x->izq;
+                    else if (comp(x->clave, clave))
+                        x = x->der;
+                    else
+                        goto terminado;
+                    ARBOL_PRECARGAR(x);
+                    actual[i++] = x;
+                    continue;
+                }
+            terminado:
+                resultados[indice[i]] = x != NIL ? &x->Info : nullptr;
+                if (siguiente < n) { // el lugar lo toma la siguiente clave
+                    indice[i] = siguiente++;
+                    actual[i++] = raiz;
+                } else {             // o el último descenso activo
+                    activos--;
+                    actual[i] = actual[activos];
+                    indice[i] = indice[activos];
+                }
+            }
+        }
     }
     
-    bool modificar(int clave, string nuevaInfo) {
+    bool modificar(const Clave& clave, const Valor& nuevaInfo) {
         nodo* n = buscarNodo(clave);
         if (n != NIL) {
+            descongelar();
             n->Info = nuevaInfo;
+            infoCambiada(n, hayAgregado());
             return true;
         }
         return false;
     }
     
+    bool modificar(const Clave& clave, Valor&& nuevaInfo) {
+        nodo* n = buscarNodo(clave);
+        if (n != NIL) {
+            descongelar();
+            n->Info = move(nuevaInfo);
+            infoCambiada(n, hayAgregado());
+            return true;
+        }
+        return false;
+    }
+    
+    // Fase de solo lectura: copia las claves y la información a dos arreglos
+    // contiguos en orden de Eytzinger (O(n)), sin punteros. Mientras el árbol
+    // no cambie, buscar y buscarLote usan esa copia: los primeros niveles
+    // comparten unas pocas líneas de caché y cada paso es una comparación
+    // sin saltos. La primera inserción, eliminación o modificación descarta
+    // la copia y las búsquedas vuelven al árbol
+    void congelar() {
+        descongelar();
+        size_t n = getTam();
+        if (n == 0) return;
+        clavesCongeladas.resize(n + 1);
+        infoCongelada.resize(n + 1);
+        nodo* siguiente = minimo(raiz);
+        llenarEytzinger(1, siguiente);
+        congelado = true;
+    }
+    
+    bool estaCongelado() const {
+        return congelado;
+    }
+    
+    // Cantidad de claves en el árbol
+    size_t getTam() const {
+        return raiz->tam;
+    }
+    
+    // Comprueba en O(n) las invariantes: orden de las claves, raíz y NIL
+    // negros, ningún rojo con hijo rojo, la misma altura negra en todos los
+    // caminos, enlaces al padre y tamaños de subárbol. Si algo falla
+    // devuelve false y deja en *error (si no es nullptr) la primera falla
+    bool verificar(string* error = nullptr) const {
+        string falla;
+        if (NIL->color != NEGRO || NIL->tam != 0)
+            falla = "centinela NIL alterado";
+        else if (raiz->color != NEGRO)
+            falla = "raíz roja";
+        else if (raiz != NIL && raiz->padre != NIL)
+            falla = "la raíz tiene padre";
+        else
+            verificarRec(raiz, NIL, NIL, NIL, 0, falla);
+        if (falla.empty()) return true;
+        if (error != nullptr) *error = falla;
+        return false;
+    }
+    
+    // Estadísticas de orden, todas en O(log n)
+    
+    // Cuántas claves son menores que clave (su posición en el inorden)
+    size_t rank(const Clave& clave) const {
+        return contarMenores(clave, false);
+    }
+    
+    // La k-ésima clave más pequeña, desde k = 0
+    Clave select(size_t k) const {
+        if (k >= raiz->tam) throw out_of_range("Posición inválida");
+        nodo* n = raiz;
+        while (true) {
+            size_t izquierda = n->izq->tam;
+            if (k < izquierda) {
+                n = n->izq;
+            } else if (k == izquierda) {
+                return n->clave;
+            } else {
+                k -= izquierda + 1; // saltamos el subárbol izquierdo y a n
+                n = n->der;
+            }
+        }
+    }
+    
+    // Cuántas claves hay en [a, b]
+    size_t contar(const Clave& a, const Clave& b) const {
+        if (comp(b, a)) return 0;
+        return contarMenores(b, true) - contarMenores(a, false);
+    }
+    
+    // Agregado de las claves en [a, b], en orden, en O(log n). Se baja hasta
+    // el primer nodo dentro del intervalo; desde ahí un camino por la
+    // izquierda junta los subárboles completos >= a y otro por la derecha
+    // los <= b, sin tocar los nodos de adentro
+    TipoAgregado agregar(const Clave& a, const Clave& b) const {
+        static_assert(hayAgregado::value, "agregar necesita un Agregado en el árbol");
+        nodo* n = raiz;
+        while (n != NIL) {
+            if (comp(n->clave, a))
+                n = n->der;
+            else if (comp(b, n->clave))
+                n = n->izq;
+            else
+                break;
+        }
+        if (n == NIL) return Agregado::neutro();
+        
+        // Todo lo de la izquierda de n es <= b: falta cortar en a
+        TipoAgregado izquierda = Agregado::neutro();
+        for (nodo* x = n->izq; x != NIL;) {
+            if (comp(x->clave, a)) {
+                x = x->der;
+            } else {
+                izquierda = Agregado::combinar(
+                    Agregado::combinar(Agregado::deNodo(x->clave, x->Info), x->der->agregado), izquierda);
+                x = x->izq;
+            }
+        }
+        // Todo lo de la derecha de n es >= a: falta cortar en b
+        TipoAgregado derecha = Agregado::neutro();
+        for (nodo* x = n->der; x != NIL;) {
+            if (comp(b, x->clave)) {
+                x = x->izq;
+            } else {
+                derecha = Agregado::combinar(
+                    derecha, Agregado::combinar(x->izq->agregado, Agregado::deNodo(x->clave, x->Info)));
+                x = x->der;
+            }
+        }
+        return Agregado::combinar(Agregado::combinar(izquierda, Agregado::deNodo(n->clave, n->Info)), derecha);
+    }
+    
+    // Agregado de todo el árbol, O(1)
+    TipoAgregado agregarTodo() const {
+        static_assert(hayAgregado::value, "agregarTodo necesita un Agregado en el árbol");
+        return raiz->agregado;
+    }
+    
+    // Iterador bidireccional en inorden: *it es la clave e it.info() su
+    // información. Sigue siendo válido mientras su nodo no se elimine
+    class iterador {
+    private:
+        nodo* n;
+        const ArbolRojiNegro* arbol;
+        
+        iterador(nodo* n, const ArbolRojiNegro* arbol) : n(n), arbol(arbol) {}
+        friend class ArbolRojiNegro;
+    
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef Clave value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Clave* pointer;
+        typedef const Clave& reference;
+        
+        iterador() : n(NULL), arbol(NULL) {}
+        
+        const Clave& operator*() const { return n->clave; }
+        const Clave* operator->() const { return &n->clave; }
+        const Clave& clave() const { return n->clave; }
+        const Valor& info() const { return n->Info; }
+        
+        iterador& operator++() {
+            n = arbol->sucesor(n);
+            return *this;
+        }
+        iterador operator++(int) {
+            iterador previo = *this;
+            ++*this;
+            return previo;
+        }
+        iterador& operator--() { // --end() es el último
+            n = n == arbol->NIL ? arbol->maximo(arbol->raiz) : arbol->predecesor(n);
+            return *this;
+        }
+        iterador operator--(int) {
+            iterador previo = *this;
+            --*this;
+            return previo;
+        }
+        
+        bool operator==(const iterador& otro) const { return n == otro.n; }
+        bool operator!=(const iterador& otro) const { return n != otro.n; }
+    };
+    
+    // Vista de las claves en [a, b]: solo recorre los nodos del intervalo
+    class Rango {
+    private:
+        iterador inicio, fin;
+    
+    public:
+        Rango(iterador inicio, iterador fin) : inicio(inicio), fin(fin) {}
+        iterador begin() const { return inicio; }
+        iterador end() const { return fin; }
+        bool empty() const { return inicio == fin; }
+    };
+    
+    iterador begin() const {
+        return iterador(minimo(raiz), this); // NIL si el árbol está vacío
+    }
+    
+    iterador end() const {
+        return iterador(NIL, this);
+    }
+    
+    // Primera clave que no es menor que clave
+    template <class K>
+    iterador lower_bound(const K& clave) const {
+        nodo* candidato = NIL;
+        nodo* n = raiz;
+        while (n != NIL) {
+            if (comp(n->clave, clave)) {
+                n = n->der;
+            } else {
+                candidato = n;
+                n = n->izq;
+            }
+        }
+        return iterador(candidato, this);
+    }
+    
+    // Primera clave mayor que clave
+    template <class K>
+    iterador upper_bound(const K& clave) const {
+        nodo* candidato = NIL;
+        nodo* n = raiz;
+        while (n != NIL) {
+            if (comp(clave, n->clave)) {
+                candidato = n;
+                n = n->izq;
+            } else {
+                n = n->der;
+            }
+        }
+        return iterador(candidato, this);
+    }
+    
+    // Todas las apariciones de clave
+    template <class K>
+    pair<iterador, iterador> equal_range(const K& clave) const {
+        return make_pair(lower_bound(clave), upper_bound(clave));
+    }
+    
+    // Claves en [a, b] en O(log n + k)
+    Rango rango(const Clave& a, const Clave& b) const {
+        if (comp(b, a)) return Rango(end(), end());
+        return Rango(lower_bound(a), upper_bound(b));
+    }
+    
+    // Operaciones con iteradores: una búsqueda devuelve un iterador y con él
+    // se modifica o se elimina sin volver a descender desde la raíz
+    
+    // El nodo con clave (cualquiera si hay repetidas), o end() si no está
+    template <class K>
+    iterador encontrar(const K& clave) const {
+        return iterador(buscarNodo(clave), this);
+    }
+    
+    // Si la clave ya está le asigna info; si no, la inserta. Un solo
+    // descenso: el mismo camino encuentra la clave o el hueco donde va.
+    // Devuelve el nodo y si fue una inserción
+    pair<iterador, bool> insertarOAsignar(const Clave& clave, const Valor& info) {
+        return asignarOCrear(clave, info);
+    }
+    
+    pair<iterador, bool> insertarOAsignar(const Clave& clave, Valor&& info) {
+        return asignarOCrear(clave, move(info));
+    }
+    
+    // Construye la información dentro del nodo con los argumentos de un
+    // constructor de Valor, sin temporales: emplazar(7, 3, 'x') guarda
+    // string(3, 'x')
+    template <class... Args>
+    iterador emplazar(const Clave& clave, Args&&... args) {
+        return iterador(insertarNodo(crearNodo(clave, forward<Args>(args)...)), this);
+    }
+    
+    // Inserción con pista: si la clave cabe justo antes de pista (o justo
+    // después) se enlaza ahí sin descender; si no, inserción normal. Con
+    // claves en orden, pasando end() o el iterador que devolvió la inserción
+    // anterior, se ahorran las comparaciones del descenso, pero sigue siendo
+    // O(log n): ubicar el vecino (el máximo con end()) baja por el árbol, y
+    // actualizar los tamaños de subárbol y rebalancear suben hasta la raíz
+    iterador insertar(iterador pista, const Clave& clave, const Valor& info) {
+        return iterador(insertarJunto(pista.n, crearNodo(clave, info)), this);
+    }
+    
+    iterador insertar(iterador pista, const Clave& clave, Valor&& info) {
+        return iterador(insertarJunto(pista.n, crearNodo(clave, move(info))), this);
+    }
+    
+    // Cambia la información del nodo de it (it != end())
+    void modificar(iterador it, const Valor& nuevaInfo) {
+        descongelar();
+        it.n->Info = nuevaInfo;
+        infoCambiada(it.n, hayAgregado());
+    }
+    
+    void modificar(iterador it, Valor&& nuevaInfo) {
+        descongelar();
+        it.n->Info = move(nuevaInfo);
+        infoCambiada(it.n, hayAgregado());
+    }
+    
+    // Elimina el nodo de it (it != end()) y devuelve el siguiente. Los demás
+    // iteradores siguen siendo válidos
+    iterador eliminar(iterador it) {
+        nodo* siguiente = sucesor(it.n);
+        eliminarNodo(it.n);
+        return iterador(siguiente, this);
+    }
+    
+private:
+    template <class V>
+    pair<iterador, bool> asignarOCrear(const Clave& clave, V&& info) {
+        nodo* y = NIL;
+        nodo* x = raiz;
+        bool aLaIzquierda = false;
+        ARBOL_INICIAR_PASOS();
+        while (x != NIL) {
+            ARBOL_CONTAR_PASO();
+            y = x;
+            if (comp(clave, x->clave)) {
+                aLaIzquierda = true;
+                x = x->izq;
+            } else if (comp(x->clave, clave)) {
+                aLaIzquierda = false;
+                x = x->der;
+            } else {
+                descongelar();
+                x->Info = forward<V>(info);
+                infoCambiada(x, hayAgregado());
+                ARBOL_REGISTRAR_DESCENSO(DESCENSO_BUSQUEDA);
+                return make_pair(iterador(x, this), false);
+            }
+        }
+        ARBOL_REGISTRAR_DESCENSO(DESCENSO_INSERCION);
+        nodo* z = crearNodo(clave, forward<V>(info));
+        enlazarInsercion(z, y, aLaIzquierda);
+        return make_pair(iterador(z, this), true);
+    }
+    
+    // Enlaza z justo antes de h si cabe ahí; si no, prueba después de h
+    // (insertarConPista) y si tampoco, desde la raíz
+    nodo* insertarJunto(nodo* h, nodo* z) {
+        const Clave& clave = z->clave;
+        nodo* antes = h == NIL ? maximo(raiz) : predecesor(h);
+        if ((h == NIL || !comp(h->clave, clave)) && (antes == NIL || !comp(clave, antes->clave))) {
+            // antes <= clave <= h: el hueco derecho de antes o el izquierdo
+            // de h está libre
+            if (antes != NIL && antes->der == NIL)
+                enlazarInsercion(z, antes, false);
+            else
+                enlazarInsercion(z, h, true);
+            return z;
+        }
+        return insertarConPista(h, z);
+    }
+    
+public:
+    
+    // Recorrido en inorden que solo entra a los subárboles cuyo agregado
+    // cumple entrar(agregado); visitar(clave, info) se llama en los nodos de
+    // esos subárboles (y decide si cada uno le sirve). Con un agregado que
+    // resume lo que hay adentro, por ejemplo el mayor final de un árbol de
+    // intervalos, una consulta de solapamiento visita O(k log n) nodos
+    template <class Entrar, class F>
+    void recorrerPodando(Entrar entrar, F visitar) const {
+        static_assert(hayAgregado::value, "recorrerPodando necesita un Agregado en el árbol");
+        recorrerPodando(raiz, entrar, visitar);
+    }
+    
+private:
+    template <class Entrar, class F>
+    void recorrerPodando(nodo* n, Entrar& entrar, F& visitar) const {
+        if (n == NIL || !entrar(n->agregado)) return;
+        recorrerPodando(n->izq, entrar, visitar);
+        visitar(n->clave, n->Info);
+        recorrerPodando(n->der, entrar, visitar);
+    }
+    
+public:
+    // Recorridos con visitante: visitar(clave, info) se llama en cada nodo.
+    // No reservan memoria: se mueven por los enlaces al padre en vez de usar
+    // una pila o una cola
+    
+    template <class F>
+    void recorrerInorden(F visitar) const {
+        for (nodo* n = minimo(raiz); n != NIL; n = sucesor(n))
+            visitar(n->clave, n->Info);
+    }
+    
+    template <class F>
+    void recorrerPreorden(F visitar) const {
+        nodo* n = raiz;
+        while (n != NIL) {
+            visitar(n->clave, n->Info);
+            if (n->izq != NIL) {
+                n = n->izq;
+            } else if (n->der != NIL) {
+                n = n->der;
+            } else { // subimos hasta un ancestro con hijo derecho sin visitar
+                while (true) {
+                    nodo* p = n->padre;
+                    if (p == NIL) return;
+                    if (n == p->izq && p->der != NIL) {
+                        n = p->der;
+                        break;
+                    }
+                    n = p;
+                }
+            }
+        }
+    }
+    
+    template <class F>
+    void recorrerPosorden(F visitar) const {
+        if (raiz == NIL) return;
+        nodo* n = primeroPosorden(raiz);
+        while (true) {
+            visitar(n->clave, n->Info);
+            nodo* p = n->padre;
+            if (p == NIL) return;
+            if (n == p->izq && p->der != NIL)
+                n = primeroPosorden(p->der); // tras el subárbol izquierdo va el derecho
+            else
+                n = p;                        // tras los dos hijos va el padre
+        }
+    }
+    
+    // Nivel por nivel, de izquierda a derecha. Cada nivel se recorre desde la
+    // raíz: O(n) en árboles llenos y O(n log n) en el peor caso
+    template <class F>
+    void recorrerPorNiveles(F visitar) const {
+        for (size_t d = 0; visitarNivel(d, visitar); d++) {}
+    }
+    
+    // Recorridos en paralelo: visitar(posicion, clave, info) se llama una
+    // vez por nodo con su posición en el orden del recorrido, y puede
+    // llamarse desde varios hilos a la vez (siempre con posiciones
+    // distintas). La posición de cada subárbol sale de los tamaños (en
+    // inorden, n va n->izq->tam lugares después del inicio de su subárbol),
+    // así que los dos hijos se reparten con el ejecutor sin esperar uno al
+    // otro. visitar no debe modificar el árbol
+    template <class Ejecutor, class F>
+    void recorrerInordenParalelo(Ejecutor& ejecutor, F visitar) const {
+        recorrerPosiciones(raiz, 0, ORDEN_INORDEN, ejecutor, visitar);
+    }
+    
+    template <class Ejecutor, class F>
+    void recorrerPreordenParalelo(Ejecutor& ejecutor, F visitar) const {
+        recorrerPosiciones(raiz, 0, ORDEN_PREORDEN, ejecutor, visitar);
+    }
+    
+    template <class Ejecutor, class F>
+    void recorrerPosordenParalelo(Ejecutor& ejecutor, F visitar) const {
+        recorrerPosiciones(raiz, 0, ORDEN_POSORDEN, ejecutor, visitar);
+    }
+    
+    // Nivel por nivel: cada nivel se reparte en bloques que se visitan en
+    // paralelo y cuentan sus hijos; con las sumas de esos conteos cada
+    // bloque sabe dónde escribir sus hijos en el nivel siguiente. O(n) en
+    // total, con dos arreglos del ancho del nivel más ancho
+    template <class Ejecutor, class F>
+    void recorrerPorNivelesParalelo(Ejecutor& ejecutor, F visitar) const {
+        if (raiz == NIL) return;
+        vector<nodo*> nivel(1, raiz), siguiente;
+        vector<size_t> hijos;
+        size_t base = 0;
+        while (!nivel.empty()) {
+            size_t m = nivel.size();
+            size_t bloques = (m + UMBRAL_PARALELO - 1) / UMBRAL_PARALELO;
+            hijos.assign(bloques + 1, 0);
+            porBloques(ejecutor, 0, bloques, [&](size_t b) {
+                size_t fin = min(m, (b + 1) * UMBRAL_PARALELO), cuenta = 0;
+                for (size_t i = b * UMBRAL_PARALELO; i < fin; i++) {
+                    nodo* n = nivel[i];
+                    visitar(base + i, n->clave, n->Info);
+                    cuenta += (n->izq != NIL) + (n->der != NIL);
+                }
+                hijos[b + 1] = cuenta;
+            });
+            for (size_t b = 0; b < bloques; b++) hijos[b + 1] += hijos[b];
+            siguiente.resize(hijos[bloques]);
+            porBloques(ejecutor, 0, bloques, [&](size_t b) {
+                size_t fin = min(m, (b + 1) * UMBRAL_PARALELO), j = hijos[b];
+                for (size_t i = b * UMBRAL_PARALELO; i < fin; i++) {
+                    if (nivel[i]->izq != NIL) siguiente[j++] = nivel[i]->izq;
+                    if (nivel[i]->der != NIL) siguiente[j++] = nivel[i]->der;
+                }
+            });
+            base += m;
+            nivel.swap(siguiente);
+        }
+    }
+    
+    // Exportación de las claves: destino debe tener lugar para getTam()
+    // claves y queda con ellas en el orden del recorrido. Sin ejecutor
+    // corren en el hilo que llama
+    template <class Ejecutor>
+    void exportarInorden(Clave* destino, Ejecutor& ejecutor) const {
+        recorrerInordenParalelo(ejecutor, [destino](size_t i, const Clave& clave, const Valor&) { destino[i] = clave; });
+    }
+    
+    template <class Ejecutor>
+    void exportarPreorden(Clave* destino, Ejecutor& ejecutor) const {
+        recorrerPreordenParalelo(ejecutor, [destino](size_t i, const Clave& clave, const Valor&) { destino[i] = clave; });
+    }
+    
+    template <class Ejecutor>
+    void exportarPosorden(Clave* destino, Ejecutor& ejecutor) const {
+        recorrerPosordenParalelo(ejecutor, [destino](size_t i, const Clave& clave, const Valor&) { destino[i] = clave; });
+    }
+    
+    template <class Ejecutor>
+    void exportarPorNiveles(Clave* destino, Ejecutor& ejecutor) const {
+        recorrerPorNivelesParalelo(ejecutor, [destino](size_t i, const Clave& clave, const Valor&) { destino[i] = clave; });
+    }
+    
+    void exportarInorden(Clave* destino) const {
+        EjecucionSecuencial secuencial;
+        exportarInorden(destino, secuencial);
+    }
+    
+    void exportarPreorden(Clave* destino) const {
+        EjecucionSecuencial secuencial;
+        exportarPreorden(destino, secuencial);
+    }
+    
+    void exportarPosorden(Clave* destino) const {
+        EjecucionSecuencial secuencial;
+        exportarPosorden(destino, secuencial);
+    }
+    
+    void exportarPorNiveles(Clave* destino) const {
+        EjecucionSecuencial secuencial;
+        exportarPorNiveles(destino, secuencial);
+    }
+    
+private:
+    enum OrdenProfundidad { ORDEN_INORDEN, ORDEN_PREORDEN, ORDEN_POSORDEN };
+    
+    // Visita el subárbol de n, cuyo primer nodo en el recorrido va en la
+    // posición base. Por debajo de UMBRAL_PARALELO los hijos van en el
+    // mismo hilo
+    template <class Ejecutor, class F>
+    void recorrerPosiciones(nodo* n, size_t base, OrdenProfundidad orden, Ejecutor& ejecutor, F& visitar) const {
+        if (n == NIL) return;
+        size_t propia, baseIzq, baseDer;
+        switch (orden) {
+            case ORDEN_INORDEN:
+                baseIzq = base;
+                propia = base + n->izq->tam;
+                baseDer = propia + 1;
+                break;
+            case ORDEN_PREORDEN:
+                propia = base;
+                baseIzq = base + 1;
+                baseDer = baseIzq + n->izq->tam;
+                break;
+            default:
+                baseIzq = base;
+                baseDer = base + n->izq->tam;
+                propia = baseDer + n->der->tam;
+                break;
+        }
+        visitar(propia, n->clave, n->Info);
+        if (n->tam < UMBRAL_PARALELO) {
+            recorrerPosiciones(n->izq, baseIzq, orden, ejecutor, visitar);
+            recorrerPosiciones(n->der, baseDer, orden, ejecutor, visitar);
+            return;
+        }
+        ejecutor.dividir([&]() { recorrerPosiciones(n->izq, baseIzq, orden, ejecutor, visitar); },
+                         [&]() { recorrerPosiciones(n->der, baseDer, orden, ejecutor, visitar); });
+    }
+    
+    // f(i) para cada i en [desde, hasta), partiendo el intervalo con el ejecutor
+    template <class Ejecutor, class F>
+    static void porBloques(Ejecutor& ejecutor, size_t desde, size_t hasta, const F& f) {
+        if (hasta - desde == 0) return;
+        if (hasta - desde == 1) {
+            f(desde);
+            return;
+        }
+        size_t medio = desde + (hasta - desde) / 2;
+        ejecutor.dividir([&]() { porBloques(ejecutor, desde, medio, f); },
+                         [&]() { porBloques(ejecutor, medio, hasta, f); });
+    }
+    
+public:
     // Impresión del Inorden
-    queue<int> inorden() {
-        queue<int> resultado;
+    queue<Clave> inorden() {
+        queue<Clave> resultado;
         if (raiz == NIL) return resultado;
         
         stack<nodo*> pila;
@@ -337,8 +2120,8 @@ public:
     }
     
     // Impresión del Preorden
-    queue<int> preorden() {
-        queue<int> resultado;
+    queue<Clave> preorden() {
+        queue<Clave> resultado;
         if (raiz == NIL) return resultado;
         
         stack<nodo*> pila;
@@ -358,8 +2141,8 @@ public:
     }
     
     // Impresión del Posorden
-    queue<int> posorden() {
-        queue<int> resultado;
+    queue<Clave> posorden() {
+        queue<Clave> resultado;
         if (raiz == NIL) return resultado;
         
         stack<nodo*> pila1, pila2;
@@ -383,9 +2166,9 @@ public:
         return resultado;
     }
     
-    // Impresión de nodos por niveles como una cola queue<int>
-    queue<int> porNiveles() {
-        queue<int> resultado;
+    // Impresión de nodos por niveles como una cola queue<Clave>
+    queue<Clave> porNiveles() {
+        queue<Clave> resultado;
         if (raiz == NIL) return resultado;
         
         queue<nodo*> cola;
@@ -403,6 +2186,10 @@ public:
         }
         return resultado;
     }
+
+private:
+    ArbolRojiNegro(const ArbolRojiNegro&);            // no copiable
+    ArbolRojiNegro& operator=(const ArbolRojiNegro&);
 };
 
 #endif
@@ -0,0 +1,570 @@
+/*
+
+Universidad Distrital Francisco José de Caldas
+
+Instantáneas en disco del Árbol RojiNegro: guardar el árbol en un archivo
+compacto y volver a abrirlo sin insertar clave por clave.
+
+Realizado por:
+
+Nicolás Martínez Pineda (20241020098)
+Ian Nicolás Sandoval Martínez (20241020078)
+
+*/
+
+// Formato (en el orden de bytes del equipo, cada sección rellenada con
+// ceros hasta un múltiplo de 8 bytes):
+//
+//     "RBSN" | uint32 versión | uint32 ancho de clave | uint32 ancho de valor |
+//     uint64 cantidad | uint64 bytes del montón |
+//     cantidad x clave (en inorden) |
+//     registros de valor | montón | uint64 suma FNV-1a de todo lo anterior
+//
+// - Con un Valor de ancho fijo (enteros, reales, structs simples) los
+//   registros son los cantidad valores, en el mismo orden que las claves,
+//   y el montón está vacío.
+// - Con Valor = string el ancho de valor es 0, los registros son
+//   cantidad + 1 desplazamientos uint64 y el texto de la clave i ocupa los
+//   bytes [desplazamiento i, desplazamiento i + 1) del montón.
+//
+// Hay dos formas de volver a abrir un archivo:
+//
+// - cargarInstantanea lo lee y arma el árbol con construirDesdeOrdenado:
+//   las claves ya vienen en orden, así que todos los nodos salen de un solo
+//   bloque y el árbol se arma balanceado en O(n), sin rebalanceos.
+// - InstantaneaMapeada lo proyecta en memoria (mmap) y busca con una
+//   búsqueda binaria directamente sobre las claves del archivo. No crea
+//   ningún nodo: abrir es O(1) y el sistema trae del disco solo las
+//   páginas que las búsquedas tocan. Es de solo lectura.
+//
+// Las claves deben ser de ancho fijo: se copian byte a byte.
+
+#ifndef INSTANTANEADISCO_H
+#define INSTANTANEADISCO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "ArbolRojiNegro.h"
+using namespace std;
+
+static const char MAGIA_INSTANTANEA[4] = { 'R', 'B', 'S', 'N' };
+static const uint32_t VERSION_INSTANTANEA = 1;
+static const size_t CABECERA_INSTANTANEA = 32;
+
+// FNV-1a de 64 bits, continuando desde suma
+inline uint64_t sumaFNV(const char* datos, size_t n, uint64_t suma = 14695981039346656037ULL) {
+    for (size_t i = 0; i < n; i++) {
+        suma ^= (unsigned char)datos[i];
+        suma *= 1099511628211ULL;
+    }
+    return suma;
+}
+
+inline size_t redondearA8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+// -----------------------------------------------------
+// Codificación de la información
+// -----------------------------------------------------
+
+// Texto dentro del archivo, sin copiarlo. datos es nullptr si la clave no
+// está; se convierte en string cuando hace falta una copia
+struct VistaTexto {
+    const char* datos;
+    size_t largo;
+
+    VistaTexto() : datos(nullptr), largo(0) {}
+    VistaTexto(const char* d, size_t l) : datos(d), largo(l) {}
+
+    explicit operator bool() const { return datos != nullptr; }
+    operator string() const { return string(datos, largo); }
+};
+
+// Cómo se guarda un Valor. Vista es lo que devuelve una búsqueda en la
+// instantánea mapeada (nula si la clave no está) y Carga lo que recibe el
+// constructor del nodo al cargar
+template <class Valor, bool = is_trivial<Valor>::value>
+struct CodificacionInstantanea; // sin definición: Valor no se puede guardar
+
+// Valor de ancho fijo: un registro de sizeof(Valor) bytes por clave
+template <class Valor>
+struct CodificacionInstantanea<Valor, true> {
+    static_assert(alignof(Valor) <= 8, "Valor debe estar alineado a lo sumo a 8 bytes");
+    typedef const Valor* Vista;
+    typedef Valor Carga;
+    static const uint32_t ANCHO = sizeof(Valor);
+
+    static size_t bytesRegistros(size_t cantidad) {
+        return cantidad * sizeof(Valor);
+    }
+
+    // Los valores en inorden, juntados durante el recorrido
+    struct Columna {
+        vector<Valor> valores;
+
+        explicit Columna(size_t cantidad) { valores.reserve(cantidad); }
+        void agregar(const Valor& info) { valores.push_back(info); }
+        uint64_t bytesMonton() const { return 0; }
+
+        template <class Escritor>
+        void escribirRegistros(Escritor& salida) const {
+            salida.escribir(valores.data(), valores.size() * sizeof(Valor));
+        }
+
+        template <class Escritor>
+        void escribirMonton(Escritor&) const {}
+    };
+
+    static Vista vista(const char* registros, const char*, uint64_t, size_t i) {
+        return (const Valor*)registros + i;
+    }
+
+    static Carga carga(const char* registros, const char*, uint64_t, size_t i) {
+        Valor v;
+        memcpy(&v, registros + i * sizeof(Valor), sizeof(Valor));
+        return v;
+    }
+};
+
+// Texto: desplazamientos en los registros y los bytes en el montón
+template <>
+struct CodificacionInstantanea<string, false> {
+    typedef VistaTexto Vista;
+    typedef VistaTexto Carga;
+    static const uint32_t ANCHO = 0;
+
+    static size_t bytesRegistros(size_t cantidad) {
+        return (cantidad + 1) * sizeof(uint64_t);
+    }
+
+    // Los textos en inorden, ya concatenados en el montón
+    struct Columna {
+        vector<uint64_t> desplazamientos;
+        string monton;
+
+        explicit Columna(size_t cantidad) {
+            desplazamientos.reserve(cantidad + 1);
+            desplazamientos.push_back(0);
+        }
+
+        void agregar(const string& info) {
+            monton += info;
+            desplazamientos.push_back(monton.size());
+        }
+
+        uint64_t bytesMonton() const { return monton.size(); }
+
+        template <class Escritor>
+        void escribirRegistros(Escritor& salida) const {
+            salida.escribir(desplazamientos.data(), desplazamientos.size() * sizeof(uint64_t));
+        }
+
+        template <class Escritor>
+        void escribirMonton(Escritor& salida) const {
+            salida.escribir(monton.data(), monton.size());
+        }
+    };
+
+    // Los desplazamientos se comprueban en cada lectura: sin verificar la
+    // suma, un archivo dañado no debe llevar a leer fuera del montón
+    static Vista vista(const char* registros, const char* monton, uint64_t bytesMonton, size_t i) {
+        const uint64_t* d = (const uint64_t*)registros;
+        if (d[i] > d[i + 1] || d[i + 1] > bytesMonton) throw invalid_argument("Instantánea dañada");
+        return VistaTexto(monton + d[i], (size_t)(d[i + 1] - d[i]));
+    }
+
+    static Carga carga(const char* registros, const char* monton, uint64_t bytesMonton, size_t i) {
+        return vista(registros, monton, bytesMonton, i);
+    }
+};
+
+// -----------------------------------------------------
+// Escritura
+// -----------------------------------------------------
+
+// Escribe con un búfer propio y lleva la suma de lo escrito
+class EscritorInstantanea {
+private:
+    static const size_t BUFER = 1 << 16;
+    ostream& salida;
+    char bufer[BUFER];
+    size_t usados;
+    uint64_t escritos;
+    uint64_t suma;
+
+    void vaciarBufer() {
+        salida.write(bufer, usados);
+        usados = 0;
+    }
+
+public:
+    explicit EscritorInstantanea(ostream& s) : salida(s), usados(0), escritos(0), suma(sumaFNV(nullptr, 0)) {}
+
+    void escribir(const void* p, size_t n) {
+        const char* datos = (const char*)p;
+        suma = sumaFNV(datos, n, suma);
+        escritos += n;
+        while (n > 0) {
+            if (usados == BUFER) vaciarBufer();
+            size_t parte = min(n, BUFER - usados);
+            memcpy(bufer + usados, datos, parte);
+            usados += parte;
+            datos += parte;
+            n -= parte;
+        }
+    }
+
+    // Ceros hasta el siguiente múltiplo de 8
+    void rellenar() {
+        static const char ceros[8] = { 0 };
+        escribir(ceros, redondearA8((size_t)escritos) - (size_t)escritos);
+    }
+
+    // Agrega la suma (que no se incluye a sí misma) y vacía el búfer
+    void terminar() {
+        uint64_t total = suma;
+        escribir(&total, sizeof(total));
+        vaciarBufer();
+    }
+};
+
+// Guarda el árbol en salida (abierta en modo binario). Un solo recorrido
+// en inorden junta las claves y la información en arreglos contiguos, que
+// luego se escriben de corrido: recorrer un árbol grande salta por toda la
+// memoria y cuesta más que la copia. Devuelve si la escritura salió bien
+template <class Clave, class Valor, class Comparar, class Agregado>
+bool guardarInstantanea(const ArbolRojiNegro<Clave, Valor, Comparar, Agregado>& arbol, ostream& salida) {
+    static_assert(is_trivial<Clave>::value, "La clave debe ser de ancho fijo");
+    static_assert(alignof(Clave) <= 8, "La clave debe estar alineada a lo sumo a 8 bytes");
+    typedef CodificacionInstantanea<Valor> Codificacion;
+
+    vector<Clave> claves;
+    claves.reserve(arbol.getTam());
+    typename Codificacion::Columna columna(arbol.getTam());
+    arbol.recorrerInorden([&](const Clave& clave, const Valor& info) {
+        claves.push_back(clave);
+        columna.agregar(info);
+    });
+
+    EscritorInstantanea escritor(salida);
+    uint32_t anchoClave = sizeof(Clave), anchoValor = Codificacion::ANCHO;
+    uint64_t cantidad = claves.size();
+    uint64_t bytesMonton = columna.bytesMonton();
+    escritor.escribir(MAGIA_INSTANTANEA, 4);
+    escritor.escribir(&VERSION_INSTANTANEA, sizeof(VERSION_INSTANTANEA));
+    escritor.escribir(&anchoClave, sizeof(anchoClave));
+    escritor.escribir(&anchoValor, sizeof(anchoValor));
+    escritor.escribir(&cantidad, sizeof(cantidad));
+    escritor.escribir(&bytesMonton, sizeof(bytesMonton));
+    escritor.escribir(claves.data(), claves.size() * sizeof(Clave));
+    escritor.rellenar();
+    columna.escribirRegistros(escritor);
+    escritor.rellenar();
+    columna.escribirMonton(escritor);
+    escritor.rellenar();
+    escritor.terminar();
+    return salida.good();
+}
+
+template <class Clave, class Valor, class Comparar, class Agregado>
+bool guardarInstantanea(const ArbolRojiNegro<Clave, Valor, Comparar, Agregado>& arbol, const string& ruta) {
+    ofstream archivo(ruta.c_str(), ios::binary | ios::trunc);
+    if (!archivo.is_open()) return false;
+    return guardarInstantanea(arbol, archivo) && archivo.flush().good();
+}
+
+// -----------------------------------------------------
+// Archivo proyectado en memoria (solo lectura)
+// -----------------------------------------------------
+class ArchivoMapeado {
+private:
+    const char* inicio;
+    size_t bytes;
+#if defined(_WIN32)
+    HANDLE archivo, mapeo;
+#endif
+
+public:
+    ArchivoMapeado() : inicio(nullptr), bytes(0) {
+#if defined(_WIN32)
+        archivo = mapeo = NULL;
+#endif
+    }
+
+    ~ArchivoMapeado() {
+        cerrar();
+    }
+
+    // Devuelve false si el archivo no se pudo abrir o proyectar
+    bool abrir(const string& ruta) {
+        cerrar();
+#if defined(_WIN32)
+        archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+        if (archivo == INVALID_HANDLE_VALUE) {
+            archivo = NULL;
+            return false;
+        }
+        LARGE_INTEGER tam;
+        if (!GetFileSizeEx(archivo, &tam)) {
+            cerrar();
+            return false;
+        }
+        bytes = (size_t)tam.QuadPart;
+        if (bytes == 0) return true; // vacío: no se puede proyectar
+        mapeo = CreateFileMappingA(archivo, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapeo != NULL) inicio = (const char*)MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0);
+        if (inicio == nullptr) {
+            cerrar();
+            return false;
+        }
+#else
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        bytes = (size_t)info.st_size;
+        if (bytes > 0) {
+            void* p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+            inicio = p != MAP_FAILED ? (const char*)p : nullptr;
+        }
+        close(fd); // la proyección sigue valiendo sin el descriptor
+        if (bytes > 0 && inicio == nullptr) {
+            bytes = 0;
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    void cerrar() {
+#if defined(_WIN32)
+        if (inicio != nullptr) UnmapViewOfFile(inicio);
+        if (mapeo != NULL) CloseHandle(mapeo);
+        if (archivo != NULL) CloseHandle(archivo);
+        archivo = mapeo = NULL;
+#else
+        if (inicio != nullptr) munmap((void*)inicio, bytes);
+#endif
+        inicio = nullptr;
+        bytes = 0;
+    }
+
+    const char* datos() const { return inicio; }
+    size_t tam() const { return bytes; }
+
+private:
+    ArchivoMapeado(const ArchivoMapeado&);            // no copiable
+    ArchivoMapeado& operator=(const ArchivoMapeado&);
+};
+
+// -----------------------------------------------------
+// Lectura
+// -----------------------------------------------------
+
+// Posición de cada sección dentro del archivo
+struct DisposicionInstantanea {
+    uint64_t cantidad;
+    uint64_t bytesMonton;
+    size_t claves, registros, monton, suma;
+};
+
+// Valida la cabecera y los tamaños contra el archivo (O(1)); con
+// verificarSuma también recorre todo el archivo y compara la suma (O(n)).
+// Lanza invalid_argument si algo no cuadra
+inline DisposicionInstantanea leerDisposicion(const char* datos, size_t bytes, uint32_t anchoClave,
+                                              uint32_t anchoValor, size_t (*bytesRegistros)(size_t),
+                                              bool verificarSuma) {
+    if (bytes < CABECERA_INSTANTANEA + sizeof(uint64_t) || memcmp(datos, MAGIA_INSTANTANEA, 4) != 0)
+        throw invalid_argument("No es una instantánea del árbol");
+    uint32_t version, ancho[2];
+    DisposicionInstantanea d;
+    memcpy(&version, datos + 4, sizeof(version));
+    memcpy(ancho, datos + 8, sizeof(ancho));
+    memcpy(&d.cantidad, datos + 16, sizeof(d.cantidad));
+    memcpy(&d.bytesMonton, datos + 24, sizeof(d.bytesMonton));
+    if (version != VERSION_INSTANTANEA)
+        throw invalid_argument("Versión de instantánea no soportada");
+    if (ancho[0] != anchoClave || ancho[1] != anchoValor)
+        throw invalid_argument("La instantánea es de otro tipo de clave o de valor");
+    // Cotas antes de multiplicar: cada clave ocupa al menos un byte
+    if (d.cantidad > bytes || d.bytesMonton > bytes)
+        throw invalid_argument("Instantánea truncada");
+
+    d.claves = CABECERA_INSTANTANEA;
+    d.registros = d.claves + redondearA8((size_t)d.cantidad * anchoClave);
+    d.monton = d.registros + redondearA8(bytesRegistros((size_t)d.cantidad));
+    d.suma = d.monton + redondearA8((size_t)d.bytesMonton);
+    if (d.suma + sizeof(uint64_t) != bytes)
+        throw invalid_argument("Instantánea truncada");
+    if (verificarSuma) {
+        uint64_t guardada;
+        memcpy(&guardada, datos + d.suma, sizeof(guardada));
+        if (sumaFNV(datos, d.suma) != guardada) throw invalid_argument("Instantánea dañada");
+    }
+    return d;
+}
+
+// Recorre las entradas del archivo como pares (clave, carga), que es lo
+// que espera construirDesdeOrdenado
+template <class Clave, class Valor>
+class LectorInstantanea {
+private:
+    typedef CodificacionInstantanea<Valor> Codificacion;
+    const char* datos;
+    const DisposicionInstantanea* d;
+    size_t i;
+    pair<Clave, typename Codificacion::Carga> actual;
+
+    void leer() {
+        if (i < d->cantidad) {
+            memcpy(&actual.first, datos + d->claves + i * sizeof(Clave), sizeof(Clave));
+            actual.second = Codificacion::carga(datos + d->registros, datos + d->monton, d->bytesMonton, i);
+        }
+    }
+
+public:
+    LectorInstantanea(const char* p, const DisposicionInstantanea& disposicion, size_t posicion)
+        : datos(p), d(&disposicion), i(posicion) {
+        leer();
+    }
+
+    const pair<Clave, typename Codificacion::Carga>* operator->() const { return &actual; }
+    const pair<Clave, typename Codificacion::Carga>& operator*() const { return actual; }
+
+    LectorInstantanea& operator++() {
+        i++;
+        leer();
+        return *this;
+    }
+
+    bool operator==(const LectorInstantanea& otro) const { return i == otro.i; }
+    bool operator!=(const LectorInstantanea& otro) const { return i != otro.i; }
+};
+
+// Reemplaza el contenido del árbol por el del archivo. Verifica la suma y
+// arma el árbol en O(n) con construirDesdeOrdenado. Devuelve false si el
+// archivo no se pudo abrir y lanza invalid_argument si no es válido
+template <class Clave, class Valor, class Comparar, class Agregado>
+bool cargarInstantanea(ArbolRojiNegro<Clave, Valor, Comparar, Agregado>& arbol, const string& ruta) {
+    static_assert(is_trivial<Clave>::value, "La clave debe ser de ancho fijo");
+    typedef CodificacionInstantanea<Valor> Codificacion;
+
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(ruta)) return false;
+    DisposicionInstantanea d = leerDisposicion(archivo.datos(), archivo.tam(), sizeof(Clave), Codificacion::ANCHO,
+                                               &Codificacion::bytesRegistros, true);
+    arbol.vaciar();
+    arbol.construirDesdeOrdenado(LectorInstantanea<Clave, Valor>(archivo.datos(), d, 0),
+                                 LectorInstantanea<Clave, Valor>(archivo.datos(), d, (size_t)d.cantidad));
+    return true;
+}
+
+// -----------------------------------------------------
+// Instantánea mapeada: búsquedas sin armar el árbol
+// -----------------------------------------------------
+template <class Clave = int, class Valor = string, class Comparar = less<Clave> >
+class InstantaneaMapeada {
+public:
+    typedef CodificacionInstantanea<Valor> Codificacion;
+    typedef typename Codificacion::Vista Vista;
+
+private:
+    static_assert(is_trivial<Clave>::value, "La clave debe ser de ancho fijo");
+    static_assert(alignof(Clave) <= 8, "La clave debe estar alineada a lo sumo a 8 bytes");
+
+    ArchivoMapeado archivo;
+    DisposicionInstantanea d;
+    const Clave* claves;
+    Comparar comp;
+
+public:
+    explicit InstantaneaMapeada(const Comparar& comparar = Comparar()) : claves(nullptr), comp(comparar) {
+        d.cantidad = 0;
+    }
+
+    // Proyecta el archivo y valida la cabecera en O(1). Con verificarSuma
+    // además lee el archivo completo y comprueba la suma. Devuelve false si
+    // no se pudo abrir y lanza invalid_argument si no es válido
+    bool abrir(const string& ruta, bool verificarSuma = false) {
+        cerrar();
+        if (!archivo.abrir(ruta)) return false;
+        try {
+            d = leerDisposicion(archivo.datos(), archivo.tam(), sizeof(Clave), Codificacion::ANCHO,
+                                &Codificacion::bytesRegistros, verificarSuma);
+        } catch (...) {
+            cerrar();
+            throw;
+        }
+        claves = (const Clave*)(archivo.datos() + d.claves);
+        return true;
+    }
+
+    void cerrar() {
+        archivo.cerrar();
+        claves = nullptr;
+        d.cantidad = 0;
+    }
+
+    size_t getTam() const {
+        return (size_t)d.cantidad;
+    }
+
+    // Posición de la primera clave que no es menor que clave (getTam() si
+    // no hay). Búsqueda binaria sin saltos: cada paso es una comparación y
+    // una selección, y la cantidad de pasos solo depende del tamaño
+    size_t posicion(const Clave& clave) const {
+        size_t n = (size_t)d.cantidad;
+        if (n == 0) return 0;
+        const Clave* base = claves;
+        while (n > 1) {
+            size_t mitad = n / 2;
+            base = comp(base[mitad], clave) ? base + mitad : base;
+            n -= mitad;
+        }
+        return (size_t)(base - claves) + (comp(*base, clave) ? 1 : 0);
+    }
+
+    // La información de la clave dentro del archivo, o una vista nula
+    // (nullptr) si no está. Vale mientras la instantánea siga abierta
+    Vista buscar(const Clave& clave) const {
+        size_t i = posicion(clave);
+        if (i < d.cantidad && !comp(clave, claves[i])) return info(i);
+        return Vista();
+    }
+
+    // Acceso por posición en inorden
+    const Clave& clave(size_t i) const {
+        return claves[i];
+    }
+
+    Vista info(size_t i) const {
+        return Codificacion::vista(archivo.datos() + d.registros, archivo.datos() + d.monton, d.bytesMonton, i);
+    }
+
+private:
+    InstantaneaMapeada(const InstantaneaMapeada&);            // no copiable
+    InstantaneaMapeada& operator=(const InstantaneaMapeada&);
+};
+
+#endif
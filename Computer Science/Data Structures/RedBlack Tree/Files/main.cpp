@@ -1,20 +1,139 @@
 #include <iostream>
 #include "ArbolRojiNegro.h"
+#include "InstantaneaDisco.h"
+#include "../../Tools/Files/lote.h"
 
 using namespace std;
 
-void mostrarCola(queue<int> cola, string nombre) {
+enum Recorrido { INORDEN, PREORDEN, POSORDEN, POR_NIVELES };
+
+// Visitante que imprime cada clave
+void imprimirClave(const int& clave, const string&) {
+    cout << clave << " ";
+}
+
+// Imprime un recorrido directamente desde el árbol, sin copiarlo en una cola
+void mostrarRecorrido(const ArbolRojiNegro<int, string>& arbol, Recorrido recorrido, string nombre) {
     cout << nombre << ": ";
-    while (!cola.empty()) {
-        cout << cola.front() << " ";
-        cola.pop();
+    switch (recorrido) {
+        case INORDEN:     arbol.recorrerInorden(imprimirClave); break;
+        case PREORDEN:    arbol.recorrerPreorden(imprimirClave); break;
+        case POSORDEN:    arbol.recorrerPosorden(imprimirClave); break;
+        case POR_NIVELES: arbol.recorrerPorNiveles(imprimirClave); break;
     }
     cout << endl;
 }
 
+// Texto de una búsqueda: la información, o un aviso si la clave no está
+string textoBusqueda(const string* info) {
+    return info != nullptr ? *info : "(no existe)";
+}
+
+// Lote de solo lectura sobre una instantánea mapeada (--mapear): no se arma
+// el árbol, las búsquedas van directo al archivo y las escrituras fallan
+int modoLoteMapeado(const vector<Operacion>& ops, const char* ruta) {
+    InstantaneaMapeada<int, string> instantanea;
+    uint64_t inicio = ahoraNs();
+    try {
+        if (!instantanea.abrir(ruta)) {
+            cerr << "No se pudo abrir la instantánea: " << ruta << "\n";
+            return 1;
+        }
+    } catch (invalid_argument& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    cout << "Instantanea mapeada: " << instantanea.getTam() << " claves en "
+         << (ahoraNs() - inicio) / 1e6 << " ms\n";
+
+    ResultadoLote r = ejecutarLote(ops, [&](const Operacion& op) -> bool {
+        if (op.tipo != OP_BUSCAR) return false; // solo lectura
+        VistaTexto info = instantanea.buscar((int)op.arg);
+        noOptimizar(info);
+        return (bool)info;
+    });
+    cout << "InstantaneaMapeada: " << ops.size() << " operaciones\n";
+    imprimirReporte(cout, r);
+    return 0;
+}
+
+// Modo por lotes: --lote <archivo|-> (el argumento de cada operación es la
+// clave). --cargar <instantánea> arma el árbol desde un archivo antes del
+// guion y --guardar <instantánea> lo guarda al final
+int modoLote(int argc, char* argv[]) {
+    vector<Operacion> ops;
+    try {
+        if (!cargarOperaciones(valorOpcion(argc, argv, "--lote"), ops)) return 1;
+    } catch (invalid_argument& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    if (const char* ruta = valorOpcion(argc, argv, "--mapear")) return modoLoteMapeado(ops, ruta);
+
+    ArbolRojiNegro<int, string> arbol;
+    if (const char* ruta = valorOpcion(argc, argv, "--cargar")) {
+        uint64_t inicio = ahoraNs();
+        try {
+            if (!cargarInstantanea(arbol, ruta)) {
+                cerr << "No se pudo abrir la instantánea: " << ruta << "\n";
+                return 1;
+            }
+        } catch (invalid_argument& e) {
+            cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        cout << "Instantanea cargada: " << arbol.getTam() << " claves en "
+             << (ahoraNs() - inicio) / 1e6 << " ms\n";
+    }
+    size_t claves = arbol.getTam();
+    ResultadoLote r = ejecutarLote(ops, [&](const Operacion& op) -> bool {
+        int clave = (int)op.arg;
+        switch (op.tipo) {
+            case OP_INSERTAR:
+                arbol.insertar(clave, op.valor);
+                claves++;
+                return true;
+            case OP_MODIFICAR:
+                return arbol.modificar(clave, op.valor);
+            case OP_ELIMINAR:
+                if (!arbol.eliminar(clave)) return false;
+                claves--;
+                return true;
+            default: {
+                const string* info = arbol.buscar(clave);
+                noOptimizar(info);
+                return info != nullptr;
+            }
+        }
+    });
+    cout << "ArbolRojiNegro: " << ops.size() << " operaciones, "
+         << claves << " claves al final\n";
+    imprimirReporte(cout, r);
+#ifdef ARBOL_INSTRUMENTADO
+    volcarEstadisticasArbolJSON(cerr);
+#endif
+    string error;
+    if (!arbol.verificar(&error)) {
+        cerr << "Invariante rota: " << error << "\n";
+        return 1;
+    }
+    if (const char* ruta = valorOpcion(argc, argv, "--guardar")) {
+        if (!guardarInstantanea(arbol, string(ruta))) {
+            cerr << "No se pudo guardar la instantánea: " << ruta << "\n";
+            return 1;
+        }
+        cout << "Instantanea guardada: " << ruta << "\n";
+    }
+    return 0;
+}
+
 // Llamada al programa principal
-int main() {
-    ArbolRojiNegro arbol; // Crear arbol de la clase ArbolRojiNegro
+int main(int argc, char* argv[]) {
+    // Modos no interactivos
+    if (tieneOpcion(argc, argv, "--generar")) return generarCargaCLI(argc, argv);
+    if (valorOpcion(argc, argv, "--lote")) return modoLote(argc, argv);
+
+    ArbolRojiNegro<int, string> arbol; // Crear arbol de la clase ArbolRojiNegro
     
     cout << "===============================================" << endl;
     cout << "    PROGRAMA DE ARBOL ROJO-NEGRO" << endl;
@@ -76,8 +195,8 @@ int main() {
     
     cout << "\n2. PRIMEROS DOS RECORRIDOS" << endl;
     cout << "-------------------------------------------" << endl;
-    mostrarCola(arbol.inorden(), "INORDEN  ");
-    mostrarCola(arbol.preorden(), "PREORDEN ");
+    mostrarRecorrido(arbol, INORDEN, "INORDEN  ");
+    mostrarRecorrido(arbol, PREORDEN, "PREORDEN ");
     
     // ========================================
     // FASE 3: Buscar clave dada por usuario
@@ -89,10 +208,10 @@ int main() {
     cout << "Ingrese una clave a buscar: "; // Pedimos la clave
     cin >> claveBuscar;
     
-    string info = arbol.buscar(claveBuscar); // Llamamos el método buscar(clave)
-    if (!info.empty()) {
+    const string* info = arbol.buscar(claveBuscar); // Llamamos el método buscar(clave)
+    if (info != nullptr) {
         cout << "\n[ENCONTRADO] Clave " << claveBuscar << endl;
-        cout << "Informacion: " << info << endl;
+        cout << "Informacion: " << *info << endl;
     } else {
         cout << "\n[NO ENCONTRADO] La clave " << claveBuscar 
              << " no existe en el arbol." << endl;
@@ -100,8 +219,8 @@ int main() {
     
     // Búsquedas adicionales de demostración
     cout << "\nBusquedas adicionales:" << endl;
-    cout << "Clave 10: " << arbol.buscar(10) << endl;
-    cout << "Clave 15: " << arbol.buscar(15) << endl;
+    cout << "Clave 10: " << textoBusqueda(arbol.buscar(10)) << endl;
+    cout << "Clave 15: " << textoBusqueda(arbol.buscar(15)) << endl;
     
     // ========================================
     // FASE 4: Eliminación de los 4 casos
@@ -113,28 +232,28 @@ int main() {
     cout << "\nCASO 1 - Eliminando nodo HOJA (20):" << endl;
     if (arbol.eliminar(20)) {
         cout << "[OK] Clave 20 eliminada (era hoja)." << endl;
-        mostrarCola(arbol.inorden(), "Arbol: ");
+        mostrarRecorrido(arbol, INORDEN, "Arbol: ");
     }
     
     // Caso 2: Eliminar nodo con UN hijo
     cout << "\nCASO 2 - Eliminando nodo con UN HIJO (1):" << endl;
     if (arbol.eliminar(1)) {
         cout << "[OK] Clave 1 eliminada (tenia un hijo)." << endl;
-        mostrarCola(arbol.inorden(), "Arbol: ");
+        mostrarRecorrido(arbol, INORDEN, "Arbol: ");
     }
     
     // Caso 3: Eliminar nodo con DOS hijos
     cout << "\nCASO 3 - Eliminando nodo con DOS HIJOS (5):" << endl;
     if (arbol.eliminar(5)) {
         cout << "[OK] Clave 5 eliminada (tenia dos hijos)." << endl;
-        mostrarCola(arbol.inorden(), "Arbol: ");
+        mostrarRecorrido(arbol, INORDEN, "Arbol: ");
     }
     
     // Caso 4: Eliminar nodo NEGRO (requiere ajuste)
     cout << "\nCASO 4 - Eliminando nodo NEGRO con ajuste (15):" << endl;
     if (arbol.eliminar(15)) {
         cout << "[OK] Clave 15 eliminada (negro, requirio ajuste)." << endl;
-        mostrarCola(arbol.inorden(), "Arbol: ");
+        mostrarRecorrido(arbol, INORDEN, "Arbol: ");
     }
     
     // ========================================
@@ -142,8 +261,8 @@ int main() {
     // ========================================
     cout << "\n5. RECORRIDOS RESTANTES" << endl;
     cout << "-------------------------------------------" << endl;
-    mostrarCola(arbol.posorden(), "POSORDEN  ");
-    mostrarCola(arbol.porNiveles(), "POR NIVELES");
+    mostrarRecorrido(arbol, POSORDEN, "POSORDEN  ");
+    mostrarRecorrido(arbol, POR_NIVELES, "POR NIVELES");
     
     // ========================================
     // DEMOSTRACIÓN ADICIONAL
@@ -156,17 +275,32 @@ int main() {
     cout << "\nModificando informacion de clave 10..." << endl;
     if (arbol.modificar(10, "Raiz modificada post-eliminaciones")) {
         cout << "[OK] Modificacion exitosa." << endl;
-        cout << "Nueva info: " << arbol.buscar(10) << endl;
+        cout << "Nueva info: " << textoBusqueda(arbol.buscar(10)) << endl;
     }
     
+    // Estadísticas de orden sobre los tamaños de subárbol
+    cout << "\nEstadisticas de orden (" << arbol.getTam() << " claves):" << endl;
+    cout << "Claves menores que 10: " << arbol.rank(10) << endl;
+    cout << "Mediana (select " << arbol.getTam() / 2 << "): " << arbol.select(arbol.getTam() / 2) << endl;
+    cout << "Claves en [6, 12]: " << arbol.contar(6, 12) << endl;
+    
+    // Consulta por rango: solo recorre los nodos del intervalo
+    cout << "Rango [6, 12]:" << endl;
+    ArbolRojiNegro<int, string>::Rango r = arbol.rango(6, 12);
+    for (ArbolRojiNegro<int, string>::iterador it = r.begin(); it != r.end(); ++it)
+        cout << "  " << *it << " -> " << it.info() << endl;
+    
     // Estado final
     cout << "\n===============================================" << endl;
     cout << "           ESTADO FINAL DEL ARBOL" << endl;
     cout << "===============================================" << endl;
-    mostrarCola(arbol.inorden(), "INORDEN FINAL");
+    mostrarRecorrido(arbol, INORDEN, "INORDEN FINAL");
     
     cout << "\n¡Programa ejecutado exitosamente!" << endl;
     cout << "===============================================\n" << endl;
     
+#ifdef ARBOL_INSTRUMENTADO
+    volcarEstadisticasArbolJSON(cerr); // contadores de la sesión
+#endif
     return 0;
 }
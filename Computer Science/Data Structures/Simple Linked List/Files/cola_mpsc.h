@@ -0,0 +1,215 @@
+// Universidad Distrital Francisco Jos de Caldas
+//
+// Hecho por: Nicols Martnez Pineda && Ian Nicols Sandoval Martnez
+//
+// Cola concurrente de VARIOS PRODUCTORES y UN CONSUMIDOR (MPSC) basada en la
+// cola de Dmitry Vyukov, con la misma idea de CABECERA y CENTINELA de Lista<T>:
+//
+// cab ---> [CAB] -> [NODO 1] -> [NODO 2] -> ... -> [NODO n] <--- cen
+//
+// - cab es un nodo ficticio que solo toca el consumidor. Al extraer, el
+//   primer nodo real pasa a ser la nueva cabecera y la vieja se recicla.
+// - cen apunta al ltimo nodo enlazado. Los productores se aduean de l con
+//   un intercambio atmico y luego lo enlazan: insertar_final es O(1) y libre
+//   de bloqueos (lock-free), sin recorrer la lista.
+// - extraer_inicio no tiene ciclos: es wait-free para el nico consumidor.
+//
+// Si un productor qued entre el intercambio y el enlace, el consumidor ve la
+// cola vaca hasta que el enlace se publique; nunca se pierde un elemento.
+
+#ifndef COLA_MPSC_H
+#define COLA_MPSC_H
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+using namespace std;
+
+// -----------------------------------------------------
+// Definicin del Nodo con enlace atmico
+// -----------------------------------------------------
+template <class T>
+struct NodoMPSC {
+    T info;                      // Informacin almacenada
+    atomic<NodoMPSC<T>*> sig;    // Enlace al siguiente nodo
+};
+
+// -----------------------------------------------------
+// Reciclaje de nodos: un cach por hilo y un depsito global
+// -----------------------------------------------------
+// Los nodos los crea un productor y los libera el consumidor, as que el cach
+// del consumidor se llena y el de los productores se vaca. Los nodos viajan
+// entre hilos en lotes por el depsito global (con mutex, fuera del camino
+// rpido): cada hilo solo toca su propio cach en cada operacin.
+template <class T>
+class DepositoNodos {
+private:
+    mutex candado;
+    NodoMPSC<T>* lotes;   // nodos libres encadenados por sig
+    size_t cantidad;
+
+public:
+    DepositoNodos() : lotes(NULL), cantidad(0) {}
+
+    ~DepositoNodos() {
+        while (lotes != NULL) {
+            NodoMPSC<T>* borrar = lotes;
+            lotes = lotes->sig.load(memory_order_relaxed);
+            delete borrar;
+        }
+    }
+
+    // Recibe una cadena [primero ... ultimo] enlazada por sig
+    void devolver(NodoMPSC<T>* primero, NodoMPSC<T>* ultimo, size_t n) {
+        lock_guard<mutex> guardia(candado);
+        ultimo->sig.store(lotes, memory_order_relaxed);
+        lotes = primero;
+        cantidad += n;
+    }
+
+    // Entrega hasta n nodos como una cadena terminada en NULL
+    NodoMPSC<T>* tomar(size_t n, size_t& entregados) {
+        lock_guard<mutex> guardia(candado);
+        NodoMPSC<T>* primero = lotes;
+        NodoMPSC<T>* ultimo = NULL;
+        entregados = 0;
+        while (lotes != NULL && entregados < n) {
+            ultimo = lotes;
+            lotes = lotes->sig.load(memory_order_relaxed);
+            entregados++;
+        }
+        if (ultimo != NULL) ultimo->sig.store(NULL, memory_order_relaxed); // cortamos la cadena
+        cantidad -= entregados;
+        return primero;
+    }
+
+    static DepositoNodos& global() {
+        static DepositoNodos d;
+        return d;
+    }
+};
+
+template <class T>
+class CacheNodos {
+private:
+    NodoMPSC<T>* libres;  // pila de nodos libres de este hilo
+    size_t cantidad;
+
+    static const size_t MAXIMO = 512; // al pasar de aqu se devuelve la mitad
+    static const size_t LOTE = 256;   // nodos que se piden o devuelven por vez
+
+public:
+    CacheNodos() : libres(NULL), cantidad(0) {}
+
+    ~CacheNodos() { // al terminar el hilo sus nodos vuelven al depsito
+        if (libres == NULL) return;
+        NodoMPSC<T>* ultimo = libres;
+        while (ultimo->sig.load(memory_order_relaxed) != NULL) ultimo = ultimo->sig.load(memory_order_relaxed);
+        DepositoNodos<T>::global().devolver(libres, ultimo, cantidad);
+    }
+
+    NodoMPSC<T>* obtener() {
+        if (libres == NULL) {
+            libres = DepositoNodos<T>::global().tomar(LOTE, cantidad);
+            if (libres == NULL) return new NodoMPSC<T>;
+        }
+        NodoMPSC<T>* nodo = libres;
+        libres = nodo->sig.load(memory_order_relaxed);
+        cantidad--;
+        return nodo;
+    }
+
+    void liberar(NodoMPSC<T>* nodo) {
+        nodo->sig.store(libres, memory_order_relaxed);
+        libres = nodo;
+        if (++cantidad > MAXIMO) {
+            // Separamos los primeros LOTE nodos y los mandamos al depsito
+            NodoMPSC<T>* ultimo = libres;
+            for (size_t i = 1; i < LOTE; i++) ultimo = ultimo->sig.load(memory_order_relaxed);
+            NodoMPSC<T>* primero = libres;
+            libres = ultimo->sig.load(memory_order_relaxed);
+            cantidad -= LOTE;
+            DepositoNodos<T>::global().devolver(primero, ultimo, LOTE);
+        }
+    }
+
+    static CacheNodos& delHilo() {
+        static thread_local CacheNodos c;
+        return c;
+    }
+};
+
+// -----------------------------------------------------
+// Definicin de la clase ColaMPSC con CABECERA y CENTINELA
+// -----------------------------------------------------
+template <class T>
+class ColaMPSC {
+private:
+    // En lneas de cach distintas: cab solo la toca el consumidor y cen
+    // la disputan los productores
+    alignas(64) NodoMPSC<T>* cab;          // Nodo cabecera (ficticio)
+    alignas(64) atomic<NodoMPSC<T>*> cen;  // ltimo nodo enlazado
+
+public:
+    // Constructor
+    ColaMPSC() {
+        cab = CacheNodos<T>::delHilo().obtener();
+        cab->sig.store(NULL, memory_order_relaxed);
+        cen.store(cab, memory_order_relaxed); // la cola vaca: cabecera y centinela coinciden
+    }
+
+    // Destructor (sin productores activos)
+    ~ColaMPSC() {
+        NodoMPSC<T>* actual = cab;
+        while (actual != NULL) {
+            NodoMPSC<T>* borrar = actual;
+            actual = actual->sig.load(memory_order_relaxed);
+            CacheNodos<T>::delHilo().liberar(borrar);
+        }
+    }
+
+    // Mtodos pblicos
+    void insertar_final(const T& infoNueva);   // cualquier hilo, lock-free
+    bool extraer_inicio(T& info);              // solo el consumidor, wait-free
+    bool lista_vacia();                        // solo el consumidor
+
+private:
+    ColaMPSC(const ColaMPSC&);                 // no copiable
+    ColaMPSC& operator=(const ColaMPSC&);
+};
+
+// -----------------------------------------------------
+// Implementaciones
+// -----------------------------------------------------
+
+template <class T>
+void ColaMPSC<T>::insertar_final(const T& infoNueva) {
+    NodoMPSC<T>* nuevo = CacheNodos<T>::delHilo().obtener(); // nodo del cach del hilo -> [?|?]
+    nuevo->info = infoNueva;
+    nuevo->sig.store(NULL, memory_order_relaxed); // ser el ltimo
+
+    // Nos adueamos del centinela: nadie ms enlazar detrs del nodo anterior
+    NodoMPSC<T>* anterior = cen.exchange(nuevo, memory_order_acq_rel);
+    // ANTES: ... -> [anterior]   cen -> [nuevo]
+    anterior->sig.store(nuevo, memory_order_release);
+    // DESPUS: ... -> [anterior] -> [nuevo] <- cen
+}
+
+template <class T>
+bool ColaMPSC<T>::extraer_inicio(T& info) {
+    NodoMPSC<T>* primero = cab->sig.load(memory_order_acquire); // primer nodo real
+    if (primero == NULL) return false; // vaca (o un productor an no enlaza)
+
+    info = primero->info;   // copiamos el dato
+    NodoMPSC<T>* viejo = cab;
+    cab = primero;          // el primer nodo real pasa a ser la cabecera
+    CacheNodos<T>::delHilo().liberar(viejo); // reciclamos la cabecera anterior
+    return true;
+}
+
+template <class T>
+bool ColaMPSC<T>::lista_vacia() {
+    return cab->sig.load(memory_order_acquire) == NULL;
+}
+
+#endif
@@ -0,0 +1,209 @@
+// Universidad Distrital Francisco Jos de Caldas
+//
+// Hecho por: Nicols Martnez Pineda && Ian Nicols Sandoval Martnez
+//
+// Conjunto ordenado concurrente con la misma forma de Lista<T>:
+//
+// cab ---> [CAB] -> [NODO 1] -> [NODO 2] -> ... -> [NODO n] -> [CEN] -> nullptr
+//
+// Los elementos van en orden creciente y sin repetir (usa operator<). CAB y
+// CEN hacen de menos y ms infinito: ningn recorrido compara contra ellos.
+//
+// Lista de Harris con punteros marcados: el bit menos significativo de sig
+// indica que el nodo est borrado lgicamente.
+// - eliminar marca primero el nodo (borrado lgico) y luego intenta
+//   desenlazarlo; si no puede, el siguiente recorrido que pase lo desenlaza.
+// - insertar enlaza con un CAS sobre el sig del anterior, que falla si el
+//   anterior fue marcado o le insertaron otro nodo detrs.
+// - contiene solo lee: no escribe ni reintenta.
+// Todo es libre de bloqueos (lock-free). Los nodos desenlazados se liberan
+// con pocas (Tools/Files/epocas.h) para no borrar nada que un lector an use.
+
+#ifndef CONJUNTO_CONCURRENTE_H
+#define CONJUNTO_CONCURRENTE_H
+#include <atomic>
+#include <cstdint>
+#include "../../Tools/Files/epocas.h"
+
+using namespace std;
+
+// -----------------------------------------------------
+// Definicin del Nodo con enlace marcable
+// -----------------------------------------------------
+template <class T>
+struct NodoConcurrente {
+    T info;                  // Informacin almacenada
+    atomic<uintptr_t> sig;   // Enlace al siguiente nodo | bit de borrado
+};
+
+// -----------------------------------------------------
+// Definicin de la clase ConjuntoConcurrente con CABECERA y CENTINELA
+// -----------------------------------------------------
+template <class T>
+class ConjuntoConcurrente {
+private:
+    typedef NodoConcurrente<T> Nodo;
+
+    Nodo* cab;               // Nodo cabecera
+    Nodo* cen;               // Nodo centinela
+    atomic<int> tam;         // Tamao (aproximado mientras hay operaciones en curso)
+    DominioEpocas dominio;   // Nodos retirados pendientes de liberar
+
+    static bool marcado(uintptr_t s) { return (s & 1) != 0; }
+    static Nodo* puntero(uintptr_t s) { return (Nodo*)(s & ~(uintptr_t)1); }
+
+    void buscar(const T& clave, Nodo*& ant, Nodo*& act, GuardiaEpoca& guardia);
+
+public:
+    // Constructor
+    ConjuntoConcurrente() : tam(0) {
+        cab = new Nodo;
+        cen = new Nodo;
+        cab->sig.store((uintptr_t)cen, memory_order_relaxed); // El conjunto vaco apunta de cabecera a centinela
+        cen->sig.store(0, memory_order_relaxed);              // Centinela marca el final
+    }
+
+    // Destructor (sin operaciones en curso)
+    ~ConjuntoConcurrente() {
+        Nodo* actual = cab;
+        while (actual != NULL) {
+            Nodo* borrar = actual;
+            actual = puntero(actual->sig.load(memory_order_relaxed));
+            delete borrar;
+        }
+        // los nodos ya desenlazados los libera el destructor de dominio
+    }
+
+    // Mtodos pblicos (seguros desde cualquier hilo)
+    bool insertar(const T& clave);
+    bool eliminar(const T& clave);
+    bool contiene(const T& clave);
+    bool conjunto_vacio();
+    int getTam();
+
+    // Recorre en orden los elementos no borrados
+    template <class F>
+    void recorrer(F visitar);
+
+private:
+    ConjuntoConcurrente(const ConjuntoConcurrente&);            // no copiable
+    ConjuntoConcurrente& operator=(const ConjuntoConcurrente&);
+};
+
+// -----------------------------------------------------
+// Implementaciones
+// -----------------------------------------------------
+
+// Deja ant y act tales que ant->info < clave <= act->info (act puede ser cen),
+// ambos sin marcar. Desenlaza por el camino los nodos marcados que encuentre.
+template <class T>
+void ConjuntoConcurrente<T>::buscar(const T& clave, Nodo*& ant, Nodo*& act, GuardiaEpoca& guardia) {
+reintentar:
+    ant = cab;
+    act = puntero(ant->sig.load(memory_order_acquire));
+    while (act != cen) {
+        uintptr_t sig = act->sig.load(memory_order_acquire);
+        if (marcado(sig)) {
+            // act est borrado: lo saltamos ... -> [ant] -> [siguiente]
+            uintptr_t esperado = (uintptr_t)act;
+            if (!ant->sig.compare_exchange_strong(esperado, sig & ~(uintptr_t)1, memory_order_acq_rel))
+                goto reintentar; // ant cambi o fue marcado: volvemos a empezar
+            guardia.retirar(act); // solo quien lo desenlaza lo retira
+            act = puntero(sig);
+            continue;
+        }
+        if (!(act->info < clave)) return;
+        ant = act;
+        act = puntero(sig);
+    }
+}
+
+template <class T>
+bool ConjuntoConcurrente<T>::insertar(const T& clave) {
+    GuardiaEpoca guardia(dominio);
+    Nodo* nuevo = NULL;
+    while (true) {
+        Nodo* ant;
+        Nodo* act;
+        buscar(clave, ant, act, guardia);
+        if (act != cen && !(clave < act->info)) { // ya est
+            delete nuevo; // nunca se public
+            return false;
+        }
+        if (nuevo == NULL) {
+            nuevo = new Nodo;
+            nuevo->info = clave;
+        }
+        nuevo->sig.store((uintptr_t)act, memory_order_relaxed);
+
+        // ANTES: ... -> [ant] -> [act]
+        uintptr_t esperado = (uintptr_t)act;
+        if (ant->sig.compare_exchange_strong(esperado, (uintptr_t)nuevo, memory_order_acq_rel)) {
+            // DESPUS: ... -> [ant] -> [nuevo] -> [act]
+            tam.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <class T>
+bool ConjuntoConcurrente<T>::eliminar(const T& clave) {
+    GuardiaEpoca guardia(dominio);
+    while (true) {
+        Nodo* ant;
+        Nodo* act;
+        buscar(clave, ant, act, guardia);
+        if (act == cen || clave < act->info) return false; // no est
+
+        // Borrado lgico: marcamos el enlace de act para que nadie enlace detrs de l
+        uintptr_t sig = act->sig.load(memory_order_acquire);
+        if (marcado(sig)) continue; // otro hilo lo est eliminando
+        if (!act->sig.compare_exchange_strong(sig, sig | 1, memory_order_acq_rel)) continue;
+        tam.fetch_sub(1, memory_order_relaxed);
+
+        // Borrado fsico: ... -> [ant] -> [siguiente]
+        uintptr_t esperado = (uintptr_t)act;
+        if (ant->sig.compare_exchange_strong(esperado, sig, memory_order_acq_rel)) guardia.retirar(act);
+        else buscar(clave, ant, act, guardia); // lo desenlaza el recorrido
+        return true;
+    }
+}
+
+template <class T>
+bool ConjuntoConcurrente<T>::contiene(const T& clave) {
+    GuardiaEpoca guardia(dominio);
+    Nodo* act = puntero(cab->sig.load(memory_order_acquire));
+    while (act != cen && act->info < clave) act = puntero(act->sig.load(memory_order_acquire));
+    return act != cen && !(clave < act->info) && !marcado(act->sig.load(memory_order_acquire));
+}
+
+template <class T>
+bool ConjuntoConcurrente<T>::conjunto_vacio() {
+    GuardiaEpoca guardia(dominio);
+    Nodo* act = puntero(cab->sig.load(memory_order_acquire));
+    while (act != cen) {
+        uintptr_t sig = act->sig.load(memory_order_acquire);
+        if (!marcado(sig)) return false;
+        act = puntero(sig);
+    }
+    return true;
+}
+
+template <class T>
+int ConjuntoConcurrente<T>::getTam() {
+    return tam.load(memory_order_relaxed);
+}
+
+template <class T>
+template <class F>
+void ConjuntoConcurrente<T>::recorrer(F visitar) {
+    GuardiaEpoca guardia(dominio);
+    Nodo* act = puntero(cab->sig.load(memory_order_acquire));
+    while (act != cen) {
+        uintptr_t sig = act->sig.load(memory_order_acquire);
+        if (!marcado(sig)) visitar(act->info);
+        act = puntero(sig);
+    }
+}
+
+#endif
@@ -13,6 +13,17 @@
 #include <cstdlib>
 #include <stdexcept>
 
+// Instrumentacin opcional (compilar con -DLISTAS_INSTRUMENTADAS); si no
+// se activa, las macros quedan vacas y no agregan ningn costo
+#ifdef LISTAS_INSTRUMENTADAS
+#include "../../Tools/Files/instrumentacion.h"
+#else
+#define LISTA_REGISTRAR_RECORRIDO(op, nodos)
+#define LISTA_REGISTRAR_RESERVA(bytes)
+#define LISTA_REGISTRAR_LIBERACION(bytes)
+#define LISTA_MEDIR_ARCHIVO(op)
+#endif
+
 using namespace std;
 
 // -----------------------------------------------------
@@ -39,11 +50,22 @@ public:
     Lista() {
         cab = new Nodo<T>;
         cen = new Nodo<T>;
+        LISTA_REGISTRAR_RESERVA(sizeof(Nodo<T>)); // cabecera
+        LISTA_REGISTRAR_RESERVA(sizeof(Nodo<T>)); // centinela
         cab->sig = cen;   // La lista vaca apunta de cabecera a centinela
         cen->sig = NULL; // Centinela marca el final
         tam = 0;
     }
 
+    // Destructor
+    ~Lista() {
+        vaciar_lista();   // liberamos los nodos reales
+        delete cab;
+        delete cen;
+        LISTA_REGISTRAR_LIBERACION(sizeof(Nodo<T>)); // cabecera
+        LISTA_REGISTRAR_LIBERACION(sizeof(Nodo<T>)); // centinela
+    }
+
     // Mtodos pblicos
     bool lista_vacia();
     int getTam();
@@ -53,6 +75,12 @@ public:
     void insertar_inicio(T infoNueva);
     void insertar_final(T infoNueva);
     void insertar_pos(T infoNueva, int pos);
+    void vaciar_lista();
+    int posicionOrdenada(T info, bool& encontrado); // para listas ordenadas
+
+private:
+    Lista(const Lista&);              // no copiable
+    Lista& operator=(const Lista&);
 };
 
 // -----------------------------------------------------
@@ -72,6 +100,7 @@ int Lista<T>::getTam() {
 template <class T>
 void Lista<T>::insertar_inicio(T infoNueva) {
     Nodo<T>* nuevo = new Nodo<T>; // insertamos new nodo "nuevo" -> [?|?]
+    LISTA_REGISTRAR_RESERVA(sizeof(Nodo<T>));
     nuevo->info = infoNueva; // asignamos los valores que queremos guardar en el nodo -> [1|A]
     nuevo->sig = cab->sig; 
 	// nuevo -> sig enlaza el primer nodo y cab -> sig al primer nodo real o al centinela si est vaco
@@ -85,10 +114,12 @@ void Lista<T>::insertar_inicio(T infoNueva) {
 template <class T>
 void Lista<T>::insertar_final(T infoNueva) {
     Nodo<T>* nuevo = new Nodo<T>; 
+    LISTA_REGISTRAR_RESERVA(sizeof(Nodo<T>));
     nuevo->info = infoNueva;
     nuevo->sig = cen; // sig apuntar al nodo centinela para que nuevo los apunte a ellos como "ltimo elemento"	
 
     Nodo<T>* actual = cab; // creamos puntero auxiliar "actual"
+    LISTA_REGISTRAR_RECORRIDO(LISTA_INSERTAR_FINAL, tam);
     while (actual->sig != cen) // se recorre el ciclo hasta encontrar el nodo cuyo sig apunta al cen (el ltimo)
 	{
         actual = actual->sig; 
@@ -103,9 +134,11 @@ void Lista<T>::insertar_pos(T infoNueva, int pos) {
     if (pos < 0 || pos > tam) throw out_of_range("Posicin invlida"); // pos vlida
 
     Nodo<T>* nuevo = new Nodo<T>; // new nodo "nuevo"
+    LISTA_REGISTRAR_RESERVA(sizeof(Nodo<T>));
     nuevo->info = infoNueva; // asignamos info
 
     Nodo<T>* actual = cab; // aux
+    LISTA_REGISTRAR_RECORRIDO(LISTA_INSERTAR_POS, pos);
     for (int i = 0; i < pos; i++) { //recorre lista pos veces 
         actual = actual->sig; //actual apunta al nodo anterior a donde se quiere insertar
     }
@@ -120,6 +153,7 @@ T Lista<T>::obtenerDato(int pos) {
     if (pos < 0 || pos >= tam) throw out_of_range("Posicin invlida"); //pos vlida
 
     Nodo<T>* actual = cab->sig; // nodo actual
+    LISTA_REGISTRAR_RECORRIDO(LISTA_OBTENER, pos);
     for (int i = 0; i < pos; i++) {
         actual = actual->sig;
     }
@@ -132,6 +166,7 @@ bool Lista<T>::modificar(int pos, T infoNueva) {
     if (pos < 0 || pos >= tam) throw out_of_range("Posicin invlida"); //pos vlida
 
     Nodo<T>* actual = cab->sig;
+    LISTA_REGISTRAR_RECORRIDO(LISTA_MODIFICAR, pos);
     for (int i = 0; i < pos; i++) { // recorrer posiciones
         actual = actual->sig; // actual apunta al nodo sig
     }
@@ -145,6 +180,7 @@ bool Lista<T>::eliminar(int pos) {
     if (pos < 0 || pos >= tam) throw out_of_range("Posicin invlida"); //pos vlido
 
     Nodo<T>* anterior = cab; //aux
+    LISTA_REGISTRAR_RECORRIDO(LISTA_ELIMINAR, pos);
     for (int i = 0; i < pos; i++) { //recorrer posicines
         anterior = anterior->sig;   //hasta llegar al nodo anterior
     }
@@ -153,9 +189,38 @@ bool Lista<T>::eliminar(int pos) {
     anterior->sig = borrar->sig; //soltamos el nodo anterior
 
     delete borrar; // eliminamos el nodo borrar
+    LISTA_REGISTRAR_LIBERACION(sizeof(Nodo<T>));
     tam--; //decrementa el tamao
     return true; //elemento eliminado
 }
 
+template <class T>
+void Lista<T>::vaciar_lista() {
+    Nodo<T>* actual = cab->sig; // aux en el primer nodo real
+    while (actual != cen) { // hasta llegar al centinela
+        Nodo<T>* borrar = actual; // aux2 = aux1
+        actual = actual->sig; // actual avanza
+        delete borrar; // eliminamos el nodo anterior
+        LISTA_REGISTRAR_LIBERACION(sizeof(Nodo<T>));
+    }
+    cab->sig = cen; // la lista vuelve a estar vaca
+    tam = 0;
+}
+
+// En una lista ordenada de menor a mayor, devuelve la posicin del primer
+// elemento que no es menor que info (tam si no hay ninguno) e indica si es igual
+template <class T>
+int Lista<T>::posicionOrdenada(T info, bool& encontrado) {
+    Nodo<T>* actual = cab->sig;
+    int pos = 0;
+    while (actual != cen && actual->info < info) { // avanzamos mientras sea menor
+        actual = actual->sig;
+        pos++;
+    }
+    LISTA_REGISTRAR_RECORRIDO(LISTA_POSICION_ORDENADA, pos);
+    encontrado = actual != cen && !(info < actual->info);
+    return pos;
+}
+
 #endif
 
@@ -5,9 +5,75 @@
 //
 #include <iostream>
 #include "lista.h"
+#include "../../Tools/Files/lote.h"
 using namespace std;
 
-int main() {
+// -----------------------------------------------------
+// Modo por lotes: las posiciones del guion se reducen al
+// rango vlido de la lista en el momento de ejecutarse
+// -----------------------------------------------------
+template <class T>
+T convertirValor(const string& texto) {
+    T val;
+    stringstream ss(texto);
+    if (!(ss >> val)) throw invalid_argument("Valor invlido: " + texto);
+    return val;
+}
+
+template <class T>
+int ejecutarLoteLista(const vector<Operacion>& ops, const char* nombreTipo) {
+    Lista<T> lista;
+    ResultadoLote r = ejecutarLote(ops, [&](const Operacion& op) -> bool {
+        int tam = lista.getTam();
+        if (op.tipo == OP_INSERTAR) {
+            lista.insertar_pos(convertirValor<T>(op.valor), posicionEnRango(op.arg, tam + 1));
+            return true;
+        }
+        if (tam == 0) return false; // nada que modificar, eliminar o buscar
+        int pos = posicionEnRango(op.arg, tam);
+        switch (op.tipo) {
+            case OP_MODIFICAR: return lista.modificar(pos, convertirValor<T>(op.valor));
+            case OP_ELIMINAR:  return lista.eliminar(pos);
+            default: {
+                T dato = lista.obtenerDato(pos);
+                noOptimizar(dato);
+                return true;
+            }
+        }
+    });
+    cout << "Lista<" << nombreTipo << ">: " << ops.size() << " operaciones, "
+         << lista.getTam() << " elementos al final\n";
+    imprimirReporte(cout, r);
+#ifdef LISTAS_INSTRUMENTADAS
+    volcarEstadisticasJSON(cerr);
+#endif
+    return 0;
+}
+
+// --lote <archivo|-> [--tipo int|float|char]
+int modoLote(int argc, char* argv[]) {
+    vector<Operacion> ops;
+    try {
+        if (!cargarOperaciones(valorOpcion(argc, argv, "--lote"), ops)) return 1;
+    } catch (invalid_argument& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    const char* tipo = valorOpcion(argc, argv, "--tipo");
+    string t = tipo ? tipo : "int";
+    if (t == "int") return ejecutarLoteLista<int>(ops, "int");
+    if (t == "float") return ejecutarLoteLista<float>(ops, "float");
+    if (t == "char") return ejecutarLoteLista<char>(ops, "char");
+    cerr << "Tipo invlido: " << t << " (use int, float o char)\n";
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Modos no interactivos
+    if (tieneOpcion(argc, argv, "--generar")) return generarCargaCLI(argc, argv);
+    if (valorOpcion(argc, argv, "--lote")) return modoLote(argc, argv);
+
 	//Creamos las listas con variables int, float y char
     Lista<int> listaEnteros;
     Lista<float> listaReales;
@@ -211,6 +277,9 @@ int main() {
     } while (opcion != 0);
 
     cout << "\nPrograma finalizado.\n";
+#ifdef LISTAS_INSTRUMENTADAS
+    volcarEstadisticasJSON(cerr); // contadores de la sesin
+#endif
     return 0;
 }
 
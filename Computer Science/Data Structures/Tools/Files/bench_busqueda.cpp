@@ -0,0 +1,116 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Búsquedas por segundo en ArbolRojiNegro<int, int>: un ciclo de buscar
+// (cada descenso espera sus propios fallos de caché) frente a buscarLote
+// (varios descensos intercalados con precarga) y frente a buscar sobre la
+// copia congelada (congelar(): arreglo de Eytzinger sin punteros).
+//
+// El árbol se llena con n claves distintas (con n = 10^7 los nodos ocupan
+// unos 480 MB, muy por encima de la caché de último nivel) y las
+// consultas, todas de claves presentes, llegan en lotes de --lote claves
+// con distribución uniforme, zipf o secuencial.
+//
+// Uso:
+//     bench_busqueda [--n 10000000] [--consultas 10000000] [--lote 4096]
+//                    [--distribucion uniforme|zipf|secuencial]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+
+using namespace std;
+
+typedef ArbolRojiNegro<int, int> Arbol;
+
+const char* NOMBRES_DISTRIBUCION[] = { "uniforme", "zipf", "secuencial" };
+
+struct Resultado {
+    const char* metodo;
+    double segundos;
+    long long suma; // de las informaciones encontradas, para comparar métodos
+};
+
+Resultado medirCiclo(const char* metodo, const Arbol& arbol, const vector<int>& consultas, size_t lote) {
+    Resultado r = { metodo, 0, 0 };
+    uint64_t inicio = ahoraNs();
+    for (size_t base = 0; base < consultas.size(); base += lote) {
+        size_t fin = base + lote < consultas.size() ? base + lote : consultas.size();
+        for (size_t i = base; i < fin; i++) {
+            if (const int* info = arbol.buscar(consultas[i])) r.suma += *info;
+        }
+    }
+    r.segundos = (ahoraNs() - inicio) / 1e9;
+    return r;
+}
+
+Resultado medirLote(const Arbol& arbol, const vector<int>& consultas, size_t lote) {
+    Resultado r = { "buscarLote", 0, 0 };
+    vector<const int*> salida(lote);
+    uint64_t inicio = ahoraNs();
+    for (size_t base = 0; base < consultas.size(); base += lote) {
+        size_t cuantas = base + lote < consultas.size() ? lote : consultas.size() - base;
+        arbol.buscarLote(&consultas[base], cuantas, &salida[0]);
+        for (size_t i = 0; i < cuantas; i++)
+            if (salida[i] != nullptr) r.suma += *salida[i];
+    }
+    r.segundos = (ahoraNs() - inicio) / 1e9;
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 10000000, numConsultas = 10000000, lote = 4096;
+    Distribucion dist = DIST_UNIFORME;
+    if (const char* v = valorOpcion(argc, argv, "--n")) n = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--consultas")) numConsultas = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--lote")) lote = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--distribucion")) {
+        if (!leerDistribucion(v, dist)) {
+            cerr << "Distribución desconocida: " << v << "\n";
+            return 1;
+        }
+    }
+    if (n == 0) n = 1;
+    if (lote == 0) lote = 1;
+
+    // Claves distintas en orden aleatorio (multiplicar por un impar es una
+    // permutación módulo 2^31): los nodos vecinos en el árbol quedan lejos en
+    // memoria, y sin repetidas todos los métodos devuelven la misma información
+    vector<int> claves(n);
+    Arbol arbol;
+    for (size_t i = 0; i < n; i++) {
+        claves[i] = (int)((i * 2654435761ULL) & 0x7FFFFFFF);
+        arbol.insertar(claves[i], (int)(i & 0xFFFF));
+    }
+    GeneradorClaves generador(dist, n, 7);
+    vector<int> consultas(numConsultas);
+    for (size_t i = 0; i < numConsultas; i++) consultas[i] = claves[generador() % n];
+
+    Resultado resultados[3];
+    resultados[0] = medirCiclo("buscar", arbol, consultas, lote);
+    resultados[1] = medirLote(arbol, consultas, lote);
+    uint64_t inicio = ahoraNs();
+    arbol.congelar();
+    double segundosCongelar = (ahoraNs() - inicio) / 1e9;
+    resultados[2] = medirCiclo("congelado", arbol, consultas, lote);
+    for (int i = 1; i < 3; i++) {
+        if (resultados[i].suma != resultados[0].suma) {
+            cerr << "Los métodos no encontraron lo mismo\n";
+            return 1;
+        }
+    }
+    cerr << "congelar: " << segundosCongelar << " s\n";
+
+    cout << "metodo,n,lote,distribucion,consultas,segundos,busquedas_s\n";
+    for (int i = 0; i < 3; i++) {
+        const Resultado& r = resultados[i];
+        cout << r.metodo << ',' << n << ',' << lote << ',' << NOMBRES_DISTRIBUCION[dist] << ','
+             << numConsultas << ',' << r.segundos << ',' << (uint64_t)(r.segundos > 0 ? numConsultas / r.segundos : 0) << '\n';
+    }
+    return 0;
+}
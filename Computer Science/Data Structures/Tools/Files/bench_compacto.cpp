@@ -0,0 +1,112 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Memoria por clave y latencia de búsqueda de ArbolRojiNegro (un nodo con
+// new por clave, enlaces de 64 bits) frente a ArbolRojiNegroCompacto (arreglo
+// contiguo, enlaces de 32 bits, información aparte).
+//
+// Para cada tamaño n se insertan n claves aleatorias con una información
+// corta (cabe en el string sin reservar aparte) y se miden:
+// - bytes por clave según contador_memoria.h (incluye la holgura del arreglo),
+// - ns por inserción,
+// - ns por búsqueda de una clave presente (promedio y percentiles).
+//
+// Uso:
+//     bench_compacto [--min-n 1000000] [--max-n 10000000] [--busquedas 1000000]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "contador_memoria.h"
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+#include "../../RedBlack Tree/Files/ArbolCompacto.h"
+
+using namespace std;
+
+struct Fila {
+    const char* disposicion;
+    uint64_t n;
+    double bytesPorClave;
+    double nsInsercion;
+    double nsBusqueda;
+    uint64_t p50, p99;
+    long picoKB;
+};
+
+template <class Arbol>
+void prepararArbol(Arbol&, uint64_t) {}
+
+template <>
+void prepararArbol(ArbolRojiNegroCompacto<int, string>& arbol, uint64_t n) {
+    arbol.reservar(n); // el arreglo no crece por duplicación durante la carga
+}
+
+template <class Arbol>
+Fila medir(const char* nombre, const vector<int>& claves, const vector<int>& consultas) {
+    Fila f;
+    f.disposicion = nombre;
+    f.n = claves.size();
+    reiniciarPicoMemoria();
+    long long bytesAntes = contadorMemoria().bytesActuales();
+    {
+        Arbol arbol;
+        prepararArbol(arbol, claves.size());
+        uint64_t inicio = ahoraNs();
+        for (size_t i = 0; i < claves.size(); i++) arbol.insertar(claves[i], "info");
+        f.nsInsercion = (double)(ahoraNs() - inicio) / claves.size();
+        f.bytesPorClave = (double)(contadorMemoria().bytesActuales() - bytesAntes) / claves.size();
+
+        // Promedio sin cronometrar cada operación
+        inicio = ahoraNs();
+        for (size_t i = 0; i < consultas.size(); i++) noOptimizar(arbol.buscar(consultas[i]));
+        f.nsBusqueda = (double)(ahoraNs() - inicio) / consultas.size();
+
+        // Percentiles sobre una muestra (cada medición suma el costo del reloj)
+        MuestrasLatencia muestras;
+        size_t m = consultas.size() < 100000 ? consultas.size() : 100000;
+        for (size_t i = 0; i < m; i++) {
+            uint64_t t = ahoraNs();
+            noOptimizar(arbol.buscar(consultas[i]));
+            muestras.agregar(ahoraNs() - t);
+        }
+        f.p50 = muestras.percentil(50);
+        f.p99 = muestras.percentil(99);
+        f.picoKB = picoMemoriaActualKB();
+    }
+    return f;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t minN = 1000000, maxN = 10000000, busquedas = 1000000;
+    if (const char* v = valorOpcion(argc, argv, "--min-n")) minN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-n")) maxN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--busquedas")) busquedas = strtoull(v, NULL, 10);
+    if (minN == 0) minN = 1;
+    if (busquedas == 0) busquedas = 1;
+
+    cout << "disposicion,n,bytes_por_clave,ns_insercion,ns_busqueda,p50_ns,p99_ns,pico_rss_kb\n";
+    for (uint64_t n = minN; n <= maxN; n *= 10) {
+        mt19937_64 motor(42);
+        vector<int> claves(n);
+        for (size_t i = 0; i < n; i++) claves[i] = (int)(motor() & 0x7FFFFFFF);
+        vector<int> consultas(busquedas);
+        for (size_t i = 0; i < busquedas; i++) consultas[i] = claves[motor() % n];
+
+        Fila filas[2] = {
+            medir<ArbolRojiNegro<int, string> >("punteros", claves, consultas),
+            medir<ArbolRojiNegroCompacto<int, string> >("compacto", claves, consultas)
+        };
+        for (int i = 0; i < 2; i++) {
+            const Fila& f = filas[i];
+            cout << f.disposicion << ',' << f.n << ',' << f.bytesPorClave << ',' << f.nsInsercion << ','
+                 << f.nsBusqueda << ',' << f.p50 << ',' << f.p99 << ',' << f.picoKB << '\n';
+        }
+    }
+    return 0;
+}
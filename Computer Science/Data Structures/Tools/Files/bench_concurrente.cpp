@@ -0,0 +1,273 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Prueba de linealizabilidad y banco de escalabilidad de ArbolConcurrente.
+//
+// 1. Estrés: cada escritor es dueño de las claves k del universo con
+//    k % escritores == su número, y cada operación escribe (o borra) en un
+//    solo escribir() la clave k y su espejo k + universo con un número de
+//    versión creciente. Antes de escribir anuncia la versión en iniciada[k]
+//    y al terminar la copia a completada[k]. Los lectores leen el par dentro
+//    de un leer() y comprueban:
+//    - que las dos claves estén iguales (la escritura se ve entera o nada);
+//    - que lo leído no sea anterior a lo que ya estaba completo cuando la
+//      lectura empezó, ni posterior a lo que estaba iniciado cuando terminó;
+//    - que un mismo lector nunca vea una versión más vieja que otra que ya vio.
+//    Al final el árbol debe coincidir con la última escritura de cada clave.
+// 2. Escalabilidad: 1, 2, 4... lectores buscando mientras un escritor
+//    inserta y elimina sin pausa, frente a un ArbolRojiNegro protegido con
+//    un mutex.
+//
+// Uso:
+//     bench_concurrente [--max-hilos 16] [--n 100000] [--ops 500000]
+//                       [--distribucion uniforme|zipf]
+//                       [--lectores-estres 4] [--escritores-estres 2]
+//                       [--ops-estres 2000] [--universo 64]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolConcurrente.h"
+
+using namespace std;
+
+typedef ArbolConcurrente<int, long long> Concurrente;
+typedef Concurrente::Arbol Arbol;
+
+// Un estado de clave: versión << 1 | 1 si la operación fue un borrado
+static uint64_t version(uint64_t estado) { return estado >> 1; }
+static bool esBorrado(uint64_t estado) { return (estado & 1) != 0; }
+
+struct Parametros {
+    int maxHilos;
+    int n;
+    uint64_t ops;              // búsquedas por lector
+    Distribucion dist;
+    int lectoresEstres;
+    int escritoresEstres;
+    uint64_t opsEstres;        // escrituras por escritor
+    int universo;
+};
+
+// -----------------------------------------------------
+// Estrés con verificación
+// -----------------------------------------------------
+bool verificarEstres(const Parametros& p) {
+    Concurrente arbol;
+    const int U = p.universo;
+    vector<atomic<uint64_t> > iniciada(U), completada(U);
+    for (int k = 0; k < U; k++) {
+        iniciada[k].store(0);
+        completada[k].store(0);
+    }
+    atomic<int> escritoresActivos(p.escritoresEstres);
+    atomic<long long> errores(0), lecturas(0);
+
+    vector<thread> hilos;
+    for (int w = 0; w < p.escritoresEstres; w++) {
+        hilos.push_back(thread([&, w]() {
+            GeneradorClaves azar(DIST_UNIFORME, U, 500 + w);
+            uint64_t siguiente = 1;
+            for (uint64_t i = 0; i < p.opsEstres; i++) {
+                int k = (int)(azar() / p.escritoresEstres * p.escritoresEstres + w);
+                if (k >= U) continue;
+                bool borrar = azar.aleatorio() % 4 == 0;
+                uint64_t estado = siguiente++ << 1 | (borrar ? 1 : 0);
+                long long v = (long long)version(estado);
+                iniciada[k].store(estado, memory_order_seq_cst);
+                arbol.escribir([&](Arbol& a) {
+                    for (int c = k; c < 2 * U; c += U) {
+                        if (borrar) a.eliminar(c);
+                        else a.insertarOAsignar(c, v);
+                    }
+                });
+                completada[k].store(estado, memory_order_seq_cst);
+            }
+            escritoresActivos--;
+        }));
+    }
+    for (int r = 0; r < p.lectoresEstres; r++) {
+        hilos.push_back(thread([&, r]() {
+            GeneradorClaves azar(DIST_UNIFORME, U, 900 + r);
+            vector<long long> visto(U, 0); // versión más nueva vista de cada clave
+            long long propias = 0;
+            while (escritoresActivos.load() > 0) {
+                int k = (int)azar();
+                uint64_t antes = completada[k].load(memory_order_seq_cst);
+                bool presente[2];
+                long long valor[2];
+                arbol.leer([&](const Arbol& a) {
+                    for (int j = 0; j < 2; j++) {
+                        Arbol::iterador it = a.lower_bound(k + j * U);
+                        presente[j] = it != a.end() && *it == k + j * U;
+                        valor[j] = presente[j] ? it.info() : 0;
+                    }
+                    return 0;
+                });
+                uint64_t despues = iniciada[k].load(memory_order_seq_cst);
+                propias++;
+
+                bool bien = presente[0] == presente[1] && valor[0] == valor[1];
+                if (presente[0]) {
+                    uint64_t v = (uint64_t)valor[0];
+                    if (v < version(antes) || v > version(despues)) bien = false;
+                    if (v == version(antes) && esBorrado(antes)) bien = false;
+                    if (valor[0] < visto[k]) bien = false;
+                    visto[k] = valor[0];
+                } else if (antes == despues && antes != 0 && !esBorrado(antes)) {
+                    bien = false; // nadie pudo borrarla durante la lectura
+                }
+                if (!bien) errores++;
+            }
+            lecturas += propias;
+        }));
+    }
+    for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+
+    // Estado final: cada clave (y su espejo) según su última escritura
+    for (int k = 0; k < U; k++) {
+        uint64_t e = completada[k].load();
+        for (int c = k; c < 2 * U; c += U) {
+            long long v = 0;
+            bool presente = arbol.buscar(c, v);
+            if ((e == 0 || esBorrado(e)) ? presente : (!presente || v != (long long)version(e))) errores++;
+        }
+    }
+    bool correcto = errores.load() == 0;
+    cerr << "estres: " << p.escritoresEstres << " escritores x " << p.opsEstres << " escrituras, "
+         << p.lectoresEstres << " lectores, " << lecturas.load() << " lecturas verificadas, "
+         << (correcto ? "correcto" : "INCORRECTO") << "\n";
+    return correcto;
+}
+
+// -----------------------------------------------------
+// Escalabilidad
+// -----------------------------------------------------
+struct AdaptadorConcurrente {
+    Concurrente arbol;
+
+    static const char* nombre() { return "ArbolConcurrente"; }
+    long long buscar(int clave) const {
+        long long info = 0;
+        arbol.buscar(clave, info);
+        return info;
+    }
+    void insertar(int clave) { arbol.insertar(clave, clave); }
+    void eliminar(int clave) { arbol.eliminar(clave); }
+};
+
+struct AdaptadorArbolConMutex {
+    Arbol arbol;
+    mutable mutex candado;
+
+    static const char* nombre() { return "ArbolRojiNegro+mutex"; }
+    long long buscar(int clave) const {
+        lock_guard<mutex> guardia(candado);
+        const long long* info = arbol.buscar(clave);
+        return info != nullptr ? *info : 0;
+    }
+    void insertar(int clave) {
+        lock_guard<mutex> guardia(candado);
+        arbol.insertar(clave, clave);
+    }
+    void eliminar(int clave) {
+        lock_guard<mutex> guardia(candado);
+        arbol.eliminar(clave);
+    }
+};
+
+// Lectores con p.ops búsquedas cada uno y un escritor que alterna insertar
+// y eliminar sobre claves impares (las pares se cargan al principio) hasta
+// que los lectores terminan. Devuelve segundos y escrituras hechas
+template <class Adaptador>
+double correr(const Parametros& p, int lectores, uint64_t& escrituras) {
+    Adaptador estructura;
+    for (int clave = 0; clave < 2 * p.n; clave += 2) estructura.insertar(clave);
+
+    atomic<bool> salida(false), fin(false);
+    atomic<int> pendientes(lectores);
+    vector<thread> hilos;
+    for (int h = 0; h < lectores; h++) {
+        hilos.push_back(thread([&, h]() {
+            GeneradorClaves claves(p.dist, 2 * p.n, 42 + h);
+            while (!salida.load(memory_order_acquire)) this_thread::yield();
+            long long suma = 0;
+            for (uint64_t i = 0; i < p.ops; i++) suma += estructura.buscar((int)claves());
+            noOptimizar(suma);
+            pendientes--;
+        }));
+    }
+    escrituras = 0;
+    thread escritor([&]() {
+        GeneradorClaves claves(DIST_UNIFORME, p.n, 7);
+        while (!salida.load(memory_order_acquire)) this_thread::yield();
+        while (pendientes.load() > 0) {
+            int clave = 2 * (int)claves() + 1;
+            estructura.insertar(clave);
+            estructura.eliminar(clave);
+            escrituras += 2;
+        }
+    });
+    uint64_t inicio = ahoraNs();
+    salida.store(true, memory_order_release);
+    for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+    double segundos = (ahoraNs() - inicio) / 1e9;
+    escritor.join();
+    return segundos;
+}
+
+template <class Adaptador>
+void medir(const Parametros& p) {
+    for (int h = 1; h <= p.maxHilos; h *= 2) {
+        uint64_t escrituras;
+        double segundos = correr<Adaptador>(p, h, escrituras);
+        uint64_t total = (uint64_t)h * p.ops;
+        cout << Adaptador::nombre() << ',' << h << ',' << p.n << ',' << total << ',' << escrituras << ','
+             << segundos << ',' << (uint64_t)(segundos > 0 ? total / segundos : 0) << ','
+             << (uint64_t)(segundos > 0 ? escrituras / segundos : 0) << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Parametros p;
+    p.maxHilos = 16;
+    p.n = 100000;
+    p.ops = 500000;
+    p.dist = DIST_UNIFORME;
+    p.lectoresEstres = 4;
+    p.escritoresEstres = 2;
+    p.opsEstres = 2000;
+    p.universo = 64;
+
+    if (const char* v = valorOpcion(argc, argv, "--max-hilos")) p.maxHilos = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--n")) p.n = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--ops")) p.ops = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--lectores-estres")) p.lectoresEstres = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--escritores-estres")) p.escritoresEstres = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--ops-estres")) p.opsEstres = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--universo")) p.universo = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--distribucion")) {
+        if (!leerDistribucion(v, p.dist)) {
+            cerr << "Distribución desconocida: " << v << "\n";
+            return 1;
+        }
+    }
+    if (p.maxHilos < 1) p.maxHilos = 1;
+    if (p.n < 1) p.n = 1;
+    if (p.universo < 1) p.universo = 1;
+    if (p.escritoresEstres < 1) p.escritoresEstres = 1;
+
+    if (!verificarEstres(p)) return 1;
+
+    cout << "estructura,lectores,n,busquedas,escrituras,segundos,busquedas_s,escrituras_s\n";
+    medir<AdaptadorConcurrente>(p);
+    medir<AdaptadorArbolConMutex>(p);
+    return 0;
+}
@@ -0,0 +1,218 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Prueba de estrés y banco de escalabilidad de ConjuntoConcurrente<T>.
+//
+// 1. Estrés: varios hilos insertan y eliminan claves de un universo pequeño
+//    (mucha contención). Cada hilo cuenta sus inserciones y eliminaciones
+//    exitosas; al final cada clave debe estar en el conjunto si y solo si
+//    sus inserciones superan en uno a sus eliminaciones, el recorrido debe
+//    salir ordenado y sin repetidos, y al destruir el conjunto la memoria
+//    debe volver a su nivel inicial (los nodos retirados se liberan todos).
+// 2. Escalabilidad: 1 a 16 hilos con una mezcla de búsquedas, inserciones y
+//    eliminaciones, frente a una Lista<T> ordenada protegida con un mutex.
+//
+// Uso:
+//     bench_conjunto [--max-hilos 16] [--universo 1000] [--ops 200000]
+//                    [--mezcla B,I,E] [--distribucion uniforme|zipf]
+//                    [--hilos-estres 8] [--ops-estres 200000]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "contador_memoria.h"
+#include "lote.h"
+#include "medicion.h"
+#include "../../Simple Linked List/Files/lista.h"
+#include "../../Simple Linked List/Files/conjunto_concurrente.h"
+
+using namespace std;
+
+// -----------------------------------------------------
+// Adaptadores: misma interfaz de conjunto ordenado
+// -----------------------------------------------------
+struct AdaptadorConjunto {
+    ConjuntoConcurrente<int> conjunto;
+
+    static const char* nombre() { return "ConjuntoConcurrente"; }
+    bool insertar(int clave) { return conjunto.insertar(clave); }
+    bool eliminar(int clave) { return conjunto.eliminar(clave); }
+    bool contiene(int clave) { return conjunto.contiene(clave); }
+};
+
+struct AdaptadorListaConMutex {
+    Lista<int> lista; // ordenada de menor a mayor
+    mutex candado;
+
+    static const char* nombre() { return "Lista+mutex"; }
+    bool insertar(int clave) {
+        lock_guard<mutex> guardia(candado);
+        bool encontrado;
+        int pos = lista.posicionOrdenada(clave, encontrado);
+        if (encontrado) return false;
+        lista.insertar_pos(clave, pos);
+        return true;
+    }
+    bool eliminar(int clave) {
+        lock_guard<mutex> guardia(candado);
+        bool encontrado;
+        int pos = lista.posicionOrdenada(clave, encontrado);
+        if (!encontrado) return false;
+        return lista.eliminar(pos);
+    }
+    bool contiene(int clave) {
+        lock_guard<mutex> guardia(candado);
+        bool encontrado;
+        lista.posicionOrdenada(clave, encontrado);
+        return encontrado;
+    }
+};
+
+struct Parametros {
+    int maxHilos;
+    int universo;
+    uint64_t ops;            // por hilo
+    int mezcla[3];           // % de búsquedas, inserciones y eliminaciones
+    Distribucion dist;
+    int hilosEstres;
+    uint64_t opsEstres;      // por hilo
+};
+
+// -----------------------------------------------------
+// Estrés con verificación
+// -----------------------------------------------------
+bool verificarEstres(const Parametros& p) {
+    long long bytesAntes = contadorMemoria().bytesActuales();
+    bool correcto = true;
+    {
+        ConjuntoConcurrente<int> conjunto;
+        vector<vector<long long> > balance(p.hilosEstres, vector<long long>(p.universo, 0));
+        vector<thread> hilos;
+        for (int h = 0; h < p.hilosEstres; h++) {
+            hilos.push_back(thread([&conjunto, &balance, &p, h]() {
+                GeneradorClaves claves(DIST_UNIFORME, p.universo, 1000 + h);
+                vector<long long>& mio = balance[h];
+                for (uint64_t i = 0; i < p.opsEstres; i++) {
+                    int clave = (int)claves();
+                    switch (claves.aleatorio() % 3) {
+                        case 0: if (conjunto.insertar(clave)) mio[clave]++; break;
+                        case 1: if (conjunto.eliminar(clave)) mio[clave]--; break;
+                        default: conjunto.contiene(clave);
+                    }
+                }
+            }));
+        }
+        for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+
+        int presentes = 0;
+        for (int clave = 0; clave < p.universo; clave++) {
+            long long neto = 0;
+            for (int h = 0; h < p.hilosEstres; h++) neto += balance[h][clave];
+            if (neto != 0 && neto != 1) correcto = false;
+            if (conjunto.contiene(clave) != (neto == 1)) correcto = false;
+            presentes += (int)neto;
+        }
+        int vistos = 0;
+        long long previo = -1;
+        conjunto.recorrer([&](int clave) {
+            if (clave <= previo) correcto = false; // desordenado o repetido
+            previo = clave;
+            vistos++;
+        });
+        if (vistos != presentes || conjunto.getTam() != presentes) correcto = false;
+        cerr << "estres: " << p.hilosEstres << " hilos x " << p.opsEstres << " ops, "
+             << presentes << " claves al final, " << (correcto ? "correcto" : "INCORRECTO") << "\n";
+    }
+    long long fugas = contadorMemoria().bytesActuales() - bytesAntes;
+    if (fugas != 0) {
+        cerr << "estres: " << fugas << " bytes sin liberar\n";
+        correcto = false;
+    }
+    return correcto;
+}
+
+// -----------------------------------------------------
+// Escalabilidad
+// -----------------------------------------------------
+template <class Adaptador>
+double correr(const Parametros& p, int numHilos) {
+    Adaptador estructura;
+    for (int clave = 0; clave < p.universo; clave += 2) estructura.insertar(clave); // mitad llena
+
+    atomic<bool> salida(false);
+    vector<thread> hilos;
+    for (int h = 0; h < numHilos; h++) {
+        hilos.push_back(thread([&estructura, &salida, &p, h]() {
+            GeneradorClaves claves(p.dist, p.universo, 42 + h);
+            while (!salida.load(memory_order_acquire)) this_thread::yield();
+            for (uint64_t i = 0; i < p.ops; i++) {
+                int clave = (int)claves();
+                int r = (int)(claves.aleatorio() % 100);
+                if (r < p.mezcla[0]) noOptimizar(estructura.contiene(clave));
+                else if (r < p.mezcla[0] + p.mezcla[1]) estructura.insertar(clave);
+                else estructura.eliminar(clave);
+            }
+        }));
+    }
+    uint64_t inicio = ahoraNs();
+    salida.store(true, memory_order_release);
+    for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+    return (ahoraNs() - inicio) / 1e9;
+}
+
+template <class Adaptador>
+void medir(const Parametros& p) {
+    for (int h = 1; h <= p.maxHilos; h *= 2) {
+        double segundos = correr<Adaptador>(p, h);
+        uint64_t total = (uint64_t)h * p.ops;
+        cout << Adaptador::nombre() << ',' << h << ',' << p.universo << ',' << total << ','
+             << segundos << ',' << (uint64_t)(segundos > 0 ? total / segundos : 0) << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Parametros p;
+    p.maxHilos = 16;
+    p.universo = 1000;
+    p.ops = 200000;
+    p.mezcla[0] = 80; p.mezcla[1] = 10; p.mezcla[2] = 10;
+    p.dist = DIST_UNIFORME;
+    p.hilosEstres = 8;
+    p.opsEstres = 200000;
+
+    if (const char* v = valorOpcion(argc, argv, "--max-hilos")) p.maxHilos = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--universo")) p.universo = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--ops")) p.ops = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--hilos-estres")) p.hilosEstres = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--ops-estres")) p.opsEstres = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--distribucion")) {
+        if (!leerDistribucion(v, p.dist)) {
+            cerr << "Distribución desconocida: " << v << "\n";
+            return 1;
+        }
+    }
+    if (const char* v = valorOpcion(argc, argv, "--mezcla")) {
+        char coma;
+        stringstream ss(v);
+        ss >> p.mezcla[0] >> coma >> p.mezcla[1] >> coma >> p.mezcla[2];
+        if (!ss || p.mezcla[0] + p.mezcla[1] + p.mezcla[2] != 100) {
+            cerr << "--mezcla debe ser B,I,E y sumar 100\n";
+            return 1;
+        }
+    }
+    if (p.maxHilos < 1) p.maxHilos = 1;
+    if (p.universo < 1) p.universo = 1;
+    if (p.hilosEstres < 1) p.hilosEstres = 1;
+
+    if (!verificarEstres(p)) return 1;
+
+    cout << "estructura,hilos,universo,ops,segundos,ops_s\n";
+    medir<AdaptadorConjunto>(p);
+    medir<AdaptadorListaConMutex>(p);
+    return 0;
+}
@@ -0,0 +1,415 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// ArbolRojiNegro<int, int> frente a std::multimap<int, int>, en dos partes.
+//
+// 1. Prueba diferencial: --lotes lotes de --ops-lote operaciones al azar
+//    (insertar, eliminar, buscar, modificar, contar, eliminarRango,
+//    insertarLote, unir, interseccion, diferencia) sobre claves de un
+//    universo chico, para que haya muchas repetidas. Cada resultado se
+//    compara con el del multimap, y las operaciones de conjuntos también el
+//    orden de las repetidas (el de insertar una a una). Al final de cada lote se
+//    llama a verificar() y el inorden del árbol (clave e información) debe
+//    ser igual al del multimap. Cada información es distinta, así se sabe
+//    qué repetida tocó eliminar o modificar. Ante la primera diferencia se
+//    informa la semilla, el lote y la operación, y el programa termina con 1.
+//
+// 2. Medición: para n = --min-n, 10 n... hasta --max-n y cada distribución
+//    (secuencial, uniforme, zipf), las dos estructuras hacen:
+//    - insertar: las claves 0..n-1, en orden con la secuencial y barajadas
+//      con las otras dos;
+//    - buscar: --consultas claves tomadas con la distribución;
+//    - recorrer: pasadas completas en inorden hasta visitar --consultas claves;
+//    - eliminar: n / 2 claves tomadas con la distribución (con zipf muchas se
+//      repiten y la segunda vez ya no están).
+//    Se reportan ns por operación, fallos de caché por operación (-1 si no
+//    hay contadores de hardware) y bytes por clave después de insertar,
+//    según contador_memoria.h. Las dos estructuras deben dar las mismas
+//    sumas en cada fase.
+//
+// Uso:
+//     bench_diferencial [--lotes 200] [--ops-lote 1000] [--universo 64]
+//                       [--semilla 42] [--min-n 1000] [--max-n 1000000]
+//                       [--consultas 1000000]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "contador_memoria.h"
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+
+using namespace std;
+
+typedef ArbolRojiNegro<int, int> Arbol;
+typedef multimap<int, int> Modelo;
+
+// -----------------------------------------------------
+// Prueba diferencial
+// -----------------------------------------------------
+
+// Informaciones de clave en el árbol y en el modelo, ordenadas
+vector<int> infosArbol(const Arbol& arbol, int clave) {
+    vector<int> infos;
+    pair<Arbol::iterador, Arbol::iterador> r = arbol.equal_range(clave);
+    for (Arbol::iterador it = r.first; it != r.second; ++it) infos.push_back(it.info());
+    sort(infos.begin(), infos.end());
+    return infos;
+}
+
+vector<int> infosModelo(const Modelo& modelo, int clave) {
+    vector<int> infos;
+    pair<Modelo::const_iterator, Modelo::const_iterator> r = modelo.equal_range(clave);
+    for (Modelo::const_iterator it = r.first; it != r.second; ++it) infos.push_back(it->second);
+    sort(infos.begin(), infos.end());
+    return infos;
+}
+
+// Lo que el modelo tiene y el árbol ya no (antes es del modelo, despues del
+// árbol; los dos ordenados)
+vector<int> faltantes(const vector<int>& antes, const vector<int>& despues) {
+    vector<int> resultado;
+    set_difference(antes.begin(), antes.end(), despues.begin(), despues.end(), back_inserter(resultado));
+    return resultado;
+}
+
+void quitarDelModelo(Modelo& modelo, int clave, int info) {
+    pair<Modelo::iterator, Modelo::iterator> r = modelo.equal_range(clave);
+    for (Modelo::iterator it = r.first; it != r.second; ++it) {
+        if (it->second == info) {
+            modelo.erase(it);
+            return;
+        }
+    }
+}
+
+// Mismo tamaño, invariantes del árbol y el mismo inorden
+bool compararCompleto(const Arbol& arbol, const Modelo& modelo, string& error) {
+    if (!arbol.verificar(&error)) return false;
+    if (arbol.getTam() != modelo.size()) {
+        error = "getTam no coincide con el tamaño del multimap";
+        return false;
+    }
+    Modelo::const_iterator m = modelo.begin();
+    for (Arbol::iterador it = arbol.begin(); it != arbol.end(); ++it, ++m) {
+        if (it.clave() != m->first || it.info() != m->second) {
+            error = "el inorden no coincide con el multimap";
+            return false;
+        }
+    }
+    return true;
+}
+
+// insertarLote, unir, interseccion o diferencia con unas pocas entradas al
+// azar (con repetidas). Las claves iguales deben quedar en el orden de
+// insertar una a una: primero las que ya estaban y después las nuevas, en
+// el orden del lote o del otro árbol
+void operacionConjunto(Arbol& arbol, Modelo& modelo, mt19937_64& motor, int universo,
+                       int& siguienteInfo, ostringstream& op, string& error) {
+    vector<pair<int, int> > entradas((size_t)(motor() % 16));
+    for (size_t i = 0; i < entradas.size(); i++)
+        entradas[i] = make_pair((int)(motor() % universo), siguienteInfo++);
+    Arbol otro;
+    for (size_t i = 0; i < entradas.size(); i++) otro.insertar(entradas[i].first, entradas[i].second);
+    Modelo claves(entradas.begin(), entradas.end());
+    bool adoptado = true; // unir, interseccion y diferencia vacían otro
+
+    switch (motor() % 4) {
+        case 0:
+            op << "insertarLote(" << entradas.size() << " entradas)";
+            arbol.insertarLote(entradas);
+            adoptado = false;
+            for (size_t i = 0; i < entradas.size(); i++) modelo.insert(entradas[i]);
+            break;
+        case 1:
+            op << "unir(" << entradas.size() << " entradas)";
+            arbol.unir(otro);
+            for (size_t i = 0; i < entradas.size(); i++) modelo.erase(entradas[i].first);
+            for (size_t i = 0; i < entradas.size(); i++) modelo.insert(entradas[i]);
+            break;
+        case 2:
+            op << "interseccion(" << entradas.size() << " entradas)";
+            arbol.interseccion(otro);
+            for (Modelo::iterator it = modelo.begin(); it != modelo.end();)
+                it = claves.count(it->first) ? next(it) : modelo.erase(it);
+            break;
+        default:
+            op << "diferencia(" << entradas.size() << " entradas)";
+            arbol.diferencia(otro);
+            for (size_t i = 0; i < entradas.size(); i++) modelo.erase(entradas[i].first);
+            break;
+    }
+    if (adoptado && otro.getTam() != 0) error = "el otro árbol no quedó vacío";
+    else compararCompleto(arbol, modelo, error);
+}
+
+// Una operación al azar. Devuelve false y deja en error la diferencia
+bool operacionAlAzar(Arbol& arbol, Modelo& modelo, mt19937_64& motor, int universo,
+                     int& siguienteInfo, string& error) {
+    int clave = (int)(motor() % universo);
+    unsigned tipo = (unsigned)(motor() % 100);
+    ostringstream op;
+
+    if (tipo < 30) {
+        op << "insertar(" << clave << ", " << siguienteInfo << ")";
+        arbol.insertar(clave, siguienteInfo);
+        modelo.insert(make_pair(clave, siguienteInfo));
+        siguienteInfo++;
+        if (infosArbol(arbol, clave) != infosModelo(modelo, clave)) error = "la clave no quedó con sus informaciones";
+
+    } else if (tipo < 58) {
+        op << "eliminar(" << clave << ")";
+        vector<int> antes = infosModelo(modelo, clave);
+        bool quito = arbol.eliminar(clave);
+        vector<int> perdidas = faltantes(antes, infosArbol(arbol, clave));
+        if (quito != !antes.empty())
+            error = quito ? "eliminó una clave ausente" : "no eliminó una clave presente";
+        else if (quito && (perdidas.size() != 1 || infosArbol(arbol, clave).size() != antes.size() - 1))
+            error = "no quitó exactamente una de las repetidas";
+        else if (quito)
+            quitarDelModelo(modelo, clave, perdidas[0]);
+
+    } else if (tipo < 78) {
+        op << "buscar(" << clave << ")";
+        const int* info = arbol.buscar(clave);
+        vector<int> infos = infosModelo(modelo, clave);
+        if ((info == nullptr) != infos.empty())
+            error = info == nullptr ? "no encontró una clave presente" : "encontró una clave ausente";
+        else if (info != nullptr && !binary_search(infos.begin(), infos.end(), *info))
+            error = "devolvió una información que la clave no tiene";
+
+    } else if (tipo < 93) {
+        op << "modificar(" << clave << ", " << siguienteInfo << ")";
+        vector<int> antes = infosModelo(modelo, clave);
+        bool cambio = arbol.modificar(clave, siguienteInfo);
+        vector<int> despues = infosArbol(arbol, clave);
+        vector<int> perdidas = faltantes(antes, despues);
+        if (cambio != !antes.empty())
+            error = cambio ? "modificó una clave ausente" : "no modificó una clave presente";
+        else if (cambio && (perdidas.size() != 1 || despues.size() != antes.size() ||
+                            !binary_search(despues.begin(), despues.end(), siguienteInfo)))
+            error = "no cambió exactamente una de las repetidas";
+        else if (cambio) {
+            pair<Modelo::iterator, Modelo::iterator> r = modelo.equal_range(clave);
+            for (Modelo::iterator it = r.first; it != r.second; ++it)
+                if (it->second == perdidas[0]) it->second = siguienteInfo;
+        }
+        siguienteInfo++;
+
+    } else {
+        int hasta = (int)(motor() % universo);
+        if (tipo < 97) {
+            op << "contar(" << clave << ", " << hasta << ")";
+            size_t esperado = clave > hasta ? 0
+                : (size_t)distance(modelo.lower_bound(clave), modelo.upper_bound(hasta));
+            if (arbol.contar(clave, hasta) != esperado) error = "cuenta distinta";
+            else if (arbol.rank(clave) != (size_t)distance(modelo.begin(), modelo.lower_bound(clave)))
+                error = "rank distinto";
+        } else if (tipo < 98) {
+            op << "eliminarRango(" << clave << ", " << hasta << ")";
+            size_t esperado = 0;
+            if (clave <= hasta) {
+                Modelo::iterator a = modelo.lower_bound(clave), b = modelo.upper_bound(hasta);
+                esperado = (size_t)distance(a, b);
+                modelo.erase(a, b);
+            }
+            if (arbol.eliminarRango(clave, hasta) != esperado) error = "eliminó otra cantidad de claves";
+        } else {
+            operacionConjunto(arbol, modelo, motor, universo, siguienteInfo, op, error);
+        }
+    }
+
+    if (error.empty()) return true;
+    error = op.str() + ": " + error;
+    return false;
+}
+
+bool pruebaDiferencial(size_t lotes, size_t opsLote, int universo, uint64_t semilla) {
+    if (lotes == 0) return true;
+    mt19937_64 motor(semilla);
+    Arbol arbol;
+    Modelo modelo;
+    int siguienteInfo = 0;
+    string error;
+    for (size_t l = 0; l < lotes; l++) {
+        for (size_t i = 0; i < opsLote; i++) {
+            if (!operacionAlAzar(arbol, modelo, motor, universo, siguienteInfo, error)) {
+                cerr << "Diferencia con semilla " << semilla << ", lote " << l << ", operación " << i
+                     << ": " << error << "\n";
+                return false;
+            }
+        }
+        if (!compararCompleto(arbol, modelo, error)) {
+            cerr << "Diferencia con semilla " << semilla << " al final del lote " << l << ": " << error << "\n";
+            return false;
+        }
+    }
+    cerr << "Prueba diferencial: " << lotes * opsLote << " operaciones en " << lotes
+         << " lotes, sin diferencias (" << arbol.getTam() << " claves al final)\n";
+    return true;
+}
+
+// -----------------------------------------------------
+// Medición
+// -----------------------------------------------------
+
+// Las mismas operaciones con los nombres de cada estructura
+void insertarEn(Arbol& arbol, int clave, int info) { arbol.insertar(clave, info); }
+void insertarEn(Modelo& modelo, int clave, int info) { modelo.insert(make_pair(clave, info)); }
+
+size_t tamanoDe(const Arbol& arbol) { return arbol.getTam(); }
+size_t tamanoDe(const Modelo& modelo) { return modelo.size(); }
+
+const int* buscarEn(const Arbol& arbol, int clave) { return arbol.buscar(clave); }
+const int* buscarEn(const Modelo& modelo, int clave) {
+    Modelo::const_iterator it = modelo.find(clave);
+    return it == modelo.end() ? nullptr : &it->second;
+}
+
+long long recorrerEn(const Arbol& arbol) {
+    long long suma = 0;
+    for (Arbol::iterador it = arbol.begin(); it != arbol.end(); ++it) suma += it.info();
+    return suma;
+}
+long long recorrerEn(const Modelo& modelo) {
+    long long suma = 0;
+    for (Modelo::const_iterator it = modelo.begin(); it != modelo.end(); ++it) suma += it->second;
+    return suma;
+}
+
+bool eliminarDe(Arbol& arbol, int clave) { return arbol.eliminar(clave); }
+bool eliminarDe(Modelo& modelo, int clave) {
+    Modelo::iterator it = modelo.find(clave);
+    if (it == modelo.end()) return false;
+    modelo.erase(it);
+    return true;
+}
+
+struct Carga {
+    vector<int> claves;    // orden de inserción
+    vector<int> consultas; // según la distribución
+    vector<int> borrar;    // según la distribución
+    size_t pasadas;        // recorridos completos
+};
+
+struct Fase {
+    const char* nombre;
+    size_t ops;
+    double segundos;
+    long long fallos; // -1 sin contador
+    long long suma;   // para comparar las estructuras
+};
+
+template <class F>
+Fase medir(const char* nombre, size_t ops, ContadorFallosCache& contador, F f) {
+    Fase fase = { nombre, ops, 0, 0, 0 };
+    contador.iniciar();
+    uint64_t inicio = ahoraNs();
+    fase.suma = f();
+    fase.segundos = (ahoraNs() - inicio) / 1e9;
+    fase.fallos = contador.detener();
+    return fase;
+}
+
+template <class Estructura>
+double medirEstructura(const Carga& c, ContadorFallosCache& contador, Fase fases[4]) {
+    long long bytesAntes = contadorMemoria().bytesActuales();
+    Estructura e;
+    fases[0] = medir("insertar", c.claves.size(), contador, [&]() {
+        for (size_t i = 0; i < c.claves.size(); i++) insertarEn(e, c.claves[i], c.claves[i] & 0xFFFF);
+        return (long long)tamanoDe(e);
+    });
+    double bytesPorClave = (double)(contadorMemoria().bytesActuales() - bytesAntes) / c.claves.size();
+
+    fases[1] = medir("buscar", c.consultas.size(), contador, [&]() {
+        long long suma = 0;
+        for (size_t i = 0; i < c.consultas.size(); i++)
+            if (const int* info = buscarEn(e, c.consultas[i])) suma += *info;
+        return suma;
+    });
+    fases[2] = medir("recorrer", c.pasadas * c.claves.size(), contador, [&]() {
+        long long suma = 0;
+        for (size_t p = 0; p < c.pasadas; p++) {
+            suma += recorrerEn(e);
+            noOptimizar(suma); // que cada pasada se haga de nuevo
+        }
+        return suma;
+    });
+    fases[3] = medir("eliminar", c.borrar.size(), contador, [&]() {
+        long long quitadas = 0;
+        for (size_t i = 0; i < c.borrar.size(); i++) quitadas += eliminarDe(e, c.borrar[i]) ? 1 : 0;
+        return quitadas;
+    });
+    return bytesPorClave;
+}
+
+int main(int argc, char* argv[]) {
+    size_t lotes = 200, opsLote = 1000, minN = 1000, maxN = 1000000, numConsultas = 1000000;
+    int universo = 64;
+    uint64_t semilla = 42;
+    if (const char* v = valorOpcion(argc, argv, "--lotes")) lotes = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--ops-lote")) opsLote = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--universo")) universo = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--semilla")) semilla = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--min-n")) minN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-n")) maxN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--consultas")) numConsultas = strtoull(v, NULL, 10);
+    if (universo < 1) universo = 1;
+    if (minN == 0) minN = 1;
+
+    if (!pruebaDiferencial(lotes, opsLote, universo, semilla)) return 1;
+
+    ContadorFallosCache contador;
+    if (!contador.disponible()) cerr << "Sin contadores de hardware: fallos_op = -1\n";
+
+    const Distribucion distribuciones[] = { DIST_SECUENCIAL, DIST_UNIFORME, DIST_ZIPF };
+    const char* nombres[] = { "secuencial", "uniforme", "zipf" };
+    cout << "estructura,distribucion,n,fase,ops,ns_op,fallos_op,bytes_clave\n";
+    for (size_t n = minN; n <= maxN; n *= 10) {
+        for (int d = 0; d < 3; d++) {
+            mt19937_64 motor(semilla);
+            Carga c;
+            c.claves.resize(n);
+            for (size_t i = 0; i < n; i++) c.claves[i] = (int)i;
+            if (distribuciones[d] != DIST_SECUENCIAL) shuffle(c.claves.begin(), c.claves.end(), motor);
+            GeneradorClaves consultas(distribuciones[d], n, semilla + 1), borrar(distribuciones[d], n, semilla + 2);
+            c.consultas.resize(numConsultas);
+            for (size_t i = 0; i < numConsultas; i++) c.consultas[i] = (int)consultas();
+            c.borrar.resize(n / 2);
+            for (size_t i = 0; i < n / 2; i++) c.borrar[i] = (int)borrar();
+            c.pasadas = (numConsultas + n - 1) / n;
+
+            Fase rn[4], mm[4];
+            double bytes[2];
+            bytes[0] = medirEstructura<Arbol>(c, contador, rn);
+            bytes[1] = medirEstructura<Modelo>(c, contador, mm);
+            for (int i = 0; i < 4; i++) {
+                if (rn[i].suma != mm[i].suma) {
+                    cerr << "Las estructuras no coinciden en " << rn[i].nombre << " (n = " << n << ", "
+                         << nombres[d] << ")\n";
+                    return 1;
+                }
+            }
+            for (int m = 0; m < 2; m++) {
+                const Fase* fases = m == 0 ? rn : mm;
+                for (int i = 0; i < 4; i++) {
+                    const Fase& f = fases[i];
+                    cout << (m == 0 ? "rojinegro" : "multimap") << ',' << nombres[d] << ',' << n << ','
+                         << f.nombre << ',' << f.ops << ',' << (f.ops > 0 ? f.segundos * 1e9 / f.ops : 0) << ','
+                         << (f.fallos < 0 ? -1.0 : (f.ops > 0 ? (double)f.fallos / f.ops : 0)) << ','
+                         << bytes[m] << '\n';
+                }
+            }
+        }
+        if (n > maxN / 10) break; // sin desbordar n *= 10
+    }
+    return 0;
+}
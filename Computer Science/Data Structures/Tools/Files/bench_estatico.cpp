@@ -0,0 +1,257 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Pruebas y medición de ArbolEstatico (tablas de consulta armadas en
+// tiempo de compilación):
+//
+// 1. Al compilar: static_assert sobre una tabla de códigos de estado (claves
+//    int) y una de programas (claves const char*): tamaño, altura, raíz y
+//    búsquedas de claves presentes y ausentes.
+// 2. Al ejecutar: árboles de 1 a 4097 entradas armados con el mismo
+//    constructor. Se comprueba que la raíz sea negra, que ningún rojo tenga
+//    un hijo rojo, que todos los caminos tengan la misma altura negra, que
+//    la altura sea la mínima, que el arreglo esté en inorden y que cada
+//    clave presente o ausente se encuentre o no. También que una entrada
+//    desordenada o con claves repetidas lance invalid_argument.
+// 3. Búsquedas por segundo en una tabla de 4096 claves pares (la mitad de
+//    las consultas no está) frente a ArbolRojiNegro<int, int> y a
+//    lower_bound sobre un vector ordenado. Salida CSV:
+//
+//        estructura,n,consultas,segundos,busquedas_s
+//
+// Cualquier diferencia se informa por stderr y el programa termina con 1.
+//
+// Uso:
+//     bench_estatico [--consultas 10000000] [--semilla 42]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolEstatico.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+
+using namespace std;
+
+// 1. Comprobaciones en tiempo de compilación
+
+constexpr EntradaEstatica<int, const char*> CODIGOS[] = {
+    { 200, "OK" }, { 201, "Creado" }, { 301, "Movido" }, { 400, "Solicitud incorrecta" },
+    { 404, "No encontrado" }, { 500, "Error interno" }, { 503, "No disponible" }
+};
+constexpr auto TABLA_CODIGOS = crearArbolEstatico(CODIGOS);
+
+static_assert(TABLA_CODIGOS.getTam() == 7, "La tabla de códigos debe tener 7 entradas");
+static_assert(TABLA_CODIGOS.altura() == 3, "7 entradas caben en 3 niveles");
+static_assert(TABLA_CODIGOS.getRaiz().clave == 400, "La raíz es la entrada del medio");
+static_assert(!TABLA_CODIGOS.getRaiz().color, "La raíz es negra");
+static_assert(TABLA_CODIGOS.contiene(404) && TABLA_CODIGOS.contiene(200) && TABLA_CODIGOS.contiene(503),
+              "Las claves presentes se encuentran");
+static_assert(!TABLA_CODIGOS.contiene(199) && !TABLA_CODIGOS.contiene(405) && !TABLA_CODIGOS.contiene(504),
+              "Las claves ausentes no se encuentran");
+static_assert(TABLA_CODIGOS.buscar(200)[0][0] == 'O' && TABLA_CODIGOS.buscar(301)[0][0] == 'M',
+              "buscar devuelve la información de la clave");
+
+constexpr EntradaEstatica<const char*, int> PROGRAMAS[] = {
+    { "Catastral", 3 }, { "Electrica", 7 }, { "Industrial", 15 }, { "Sistemas", 20 }, { "Sistemas2", 21 }
+};
+constexpr auto TABLA_PROGRAMAS = crearArbolEstatico(PROGRAMAS);
+
+static_assert(TABLA_PROGRAMAS.getTam() == 5, "La tabla de programas debe tener 5 entradas");
+static_assert(*TABLA_PROGRAMAS.buscar("Catastral") == 3 && *TABLA_PROGRAMAS.buscar("Industrial") == 15,
+              "Las claves de texto se comparan por contenido");
+static_assert(*TABLA_PROGRAMAS.buscar("Sistemas") == 20 && *TABLA_PROGRAMAS.buscar("Sistemas2") == 21,
+              "Un prefijo es menor que la clave que lo extiende");
+static_assert(!TABLA_PROGRAMAS.contiene("Sist") && !TABLA_PROGRAMAS.contiene("Z") && !TABLA_PROGRAMAS.contiene(""),
+              "Las claves de texto ausentes no se encuentran");
+
+// 2. Comprobaciones en tiempo de ejecución
+
+// Devuelve la altura negra del subárbol de i (contando las hojas nulas) o
+// -1 si tiene un rojo con hijo rojo o dos caminos de distinta altura negra
+template <class A>
+int alturaNegra(const A& a, uint32_t i, bool padreRojo) {
+    if (i == A::SIN_HIJO) return 1;
+    const typename A::nodo& n = a[i];
+    if (padreRojo && n.color == A::ROJO) return -1;
+    int izq = alturaNegra(a, n.izq, n.color == A::ROJO);
+    int der = alturaNegra(a, n.der, n.color == A::ROJO);
+    if (izq < 0 || izq != der) return -1;
+    return izq + (n.color == A::NEGRO ? 1 : 0);
+}
+
+// Arma en tiempo de ejecución un árbol de N entradas con claves 1, 3, 5...
+// y devuelve cuántas comprobaciones fallaron
+template <size_t N>
+int probarTam() {
+    typedef ArbolEstatico<int, int, N> Arbol;
+    static EntradaEstatica<int, int> entradas[N];
+    for (size_t i = 0; i < N; i++) {
+        entradas[i].clave = (int)(2 * i + 1);
+        entradas[i].info = (int)i;
+    }
+    static Arbol arbol(entradas);   // static: 4097 nodos no caben cómodos en la pila
+    int fallas = 0;
+
+    if (arbol.getRaiz().color != Arbol::NEGRO) {
+        cerr << "N = " << N << ": la raíz es roja\n";
+        fallas++;
+    }
+    uint32_t raiz = (uint32_t)(&arbol.getRaiz() - arbol.begin());
+    if (alturaNegra(arbol, raiz, false) < 0) {
+        cerr << "N = " << N << ": hay un rojo con hijo rojo o alturas negras distintas\n";
+        fallas++;
+    }
+    size_t minima = 0;
+    while (((size_t)1 << minima) - 1 < N) minima++;
+    if (arbol.altura() != minima) {
+        cerr << "N = " << N << ": altura " << arbol.altura() << ", se esperaba " << minima << "\n";
+        fallas++;
+    }
+    size_t i = 0;
+    bool enOrden = true;
+    arbol.recorrerInorden([&](const int& clave, const int&) {
+        if (i >= N || arbol[i].clave != clave) enOrden = false;
+        i++;
+    });
+    if (!enOrden || i != N) {
+        cerr << "N = " << N << ": el recorrido inorden no es el arreglo\n";
+        fallas++;
+    }
+    for (int k = -1; k <= (int)(2 * N + 1); k++) {
+        const int* info = arbol.buscar(k);
+        bool presente = k > 0 && k % 2 == 1 && k < (int)(2 * N);
+        if (presente ? (info == nullptr || *info != k / 2) : info != nullptr) {
+            cerr << "N = " << N << ": buscar(" << k << ") falló\n";
+            fallas++;
+            break;
+        }
+    }
+    return fallas;
+}
+
+template <size_t N>
+bool lanzaInvalido(const EntradaEstatica<int, int> (&entradas)[N]) {
+    try {
+        ArbolEstatico<int, int, N> arbol(entradas);
+        noOptimizar(arbol.getTam());
+    } catch (const invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int probarTodo() {
+    int fallas = 0;
+    fallas += probarTam<1>();
+    fallas += probarTam<2>();
+    fallas += probarTam<3>();
+    fallas += probarTam<4>();
+    fallas += probarTam<5>();
+    fallas += probarTam<7>();
+    fallas += probarTam<8>();
+    fallas += probarTam<15>();
+    fallas += probarTam<16>();
+    fallas += probarTam<17>();
+    fallas += probarTam<100>();
+    fallas += probarTam<1000>();
+    fallas += probarTam<4095>();
+    fallas += probarTam<4096>();
+    fallas += probarTam<4097>();
+
+    EntradaEstatica<int, int> desordenada[] = { { 1, 1 }, { 3, 3 }, { 2, 2 } };
+    EntradaEstatica<int, int> repetida[] = { { 1, 1 }, { 1, 2 } };
+    EntradaEstatica<int, int> alFinal[] = { { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 }, { 5, 5 }, { 0, 0 } };
+    if (!lanzaInvalido(desordenada)) {
+        cerr << "Una entrada desordenada no lanzó invalid_argument\n";
+        fallas++;
+    }
+    if (!lanzaInvalido(repetida)) {
+        cerr << "Una entrada con claves repetidas no lanzó invalid_argument\n";
+        fallas++;
+    }
+    if (!lanzaInvalido(alFinal)) {
+        cerr << "Una entrada desordenada al final no lanzó invalid_argument\n";
+        fallas++;
+    }
+    return fallas;
+}
+
+// 3. Medición
+
+const size_t TAM_TABLA = 4096;
+
+struct Resultado {
+    const char* estructura;
+    double segundos;
+    long long suma; // de las informaciones encontradas, para comparar estructuras
+};
+
+template <class Buscar>
+Resultado medir(const char* estructura, const vector<int>& consultas, Buscar buscar) {
+    Resultado r = { estructura, 0, 0 };
+    uint64_t inicio = ahoraNs();
+    for (size_t i = 0; i < consultas.size(); i++) {
+        if (const int* info = buscar(consultas[i])) r.suma += *info;
+    }
+    r.segundos = (ahoraNs() - inicio) / 1e9;
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    size_t numConsultas = 10000000;
+    unsigned semilla = 42;
+    if (const char* v = valorOpcion(argc, argv, "--consultas")) numConsultas = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--semilla")) semilla = (unsigned)strtoul(v, NULL, 10);
+
+    int fallas = probarTodo();
+    if (fallas > 0) {
+        cerr << fallas << " comprobaciones fallaron\n";
+        return 1;
+    }
+    cerr << "ArbolEstatico: comprobaciones correctas\n";
+
+    // Claves pares: la mitad de las consultas (las impares) no están
+    static EntradaEstatica<int, int> entradas[TAM_TABLA];
+    vector<int> ordenadas(TAM_TABLA), infos(TAM_TABLA);
+    ArbolRojiNegro<int, int> rojinegro;
+    for (size_t i = 0; i < TAM_TABLA; i++) {
+        entradas[i].clave = ordenadas[i] = (int)(2 * i);
+        entradas[i].info = infos[i] = (int)i;
+        rojinegro.insertar((int)(2 * i), (int)i);
+    }
+    static const ArbolEstatico<int, int, TAM_TABLA> estatico(entradas);
+
+    mt19937 motor(semilla);
+    vector<int> consultas(numConsultas);
+    for (size_t i = 0; i < numConsultas; i++) consultas[i] = (int)(motor() % (2 * TAM_TABLA));
+
+    Resultado resultados[3];
+    resultados[0] = medir("lower_bound", consultas, [&](int k) -> const int* {
+        vector<int>::const_iterator it = lower_bound(ordenadas.begin(), ordenadas.end(), k);
+        return it != ordenadas.end() && *it == k ? &infos[it - ordenadas.begin()] : nullptr;
+    });
+    resultados[1] = medir("rojinegro", consultas, [&](int k) { return rojinegro.buscar(k); });
+    resultados[2] = medir("estatico", consultas, [&](int k) { return estatico.buscar(k); });
+    for (int i = 1; i < 3; i++) {
+        if (resultados[i].suma != resultados[0].suma) {
+            cerr << resultados[i].estructura << " no encontró lo mismo que lower_bound\n";
+            return 1;
+        }
+    }
+
+    cout << "estructura,n,consultas,segundos,busquedas_s\n";
+    for (int i = 0; i < 3; i++) {
+        const Resultado& r = resultados[i];
+        cout << r.estructura << ',' << TAM_TABLA << ',' << numConsultas << ',' << r.segundos << ','
+             << (uint64_t)(r.segundos > 0 ? numConsultas / r.segundos : 0) << '\n';
+    }
+    return 0;
+}
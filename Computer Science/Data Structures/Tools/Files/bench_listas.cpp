@@ -0,0 +1,351 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Banco de pruebas de rendimiento: Lista<T> y ListaDoble<T> frente a
+// std::list, std::forward_list, std::deque y std::vector.
+//
+// Para cada contenedor, tipo T y tamaño n se llena el contenedor con n
+// elementos y se miden k operaciones de cada tipo sobre ese tamaño. Cuando
+// la operación es O(n) en el contenedor, k se recorta para que el trabajo
+// total no pase de --max-visitas nodos. La salida es CSV o JSON con ns/op,
+// reservas de memoria por operación y pico de RSS.
+//
+// Uso:
+//     bench_listas [--formato csv|json] [--min-n 100] [--max-n 1000000]
+//                  [--tipos int,float,char,Persona] [--max-visitas 50000000]
+
+#include <cstdio>
+#include <deque>
+#include <forward_list>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "contador_memoria.h"
+#include "lote.h"
+#include "medicion.h"
+#include "../../Simple Linked List/Files/lista.h"
+#include "../../Doubly Linked List/Files/lista_doble.h"
+#include "../../Doubly Linked List/Files/persona.h"
+
+using namespace std;
+
+// -----------------------------------------------------
+// Valores de prueba por tipo
+// -----------------------------------------------------
+template <class T> T valorPrueba(size_t i) { return (T)i; }
+template <> char valorPrueba<char>(size_t i) { return (char)('a' + i % 26); }
+template <> Persona valorPrueba<Persona>(size_t i) {
+    ostringstream s;
+    s << i;
+    return Persona(s.str(), "Persona " + s.str(), "2024" + s.str(), "Ingeniería de Sistemas", 18 + (int)(i % 10));
+}
+
+template <class T> const char* nombreTipo();
+template <> const char* nombreTipo<int>() { return "int"; }
+template <> const char* nombreTipo<float>() { return "float"; }
+template <> const char* nombreTipo<char>() { return "char"; }
+template <> const char* nombreTipo<Persona>() { return "Persona"; }
+
+// -----------------------------------------------------
+// Adaptadores: misma interfaz para todos los contenedores.
+// frenteO1 / finalO1 / accesoO1 indican el costo de cada operación
+// para decidir cuántas repeticiones caben en el presupuesto.
+// -----------------------------------------------------
+template <class T>
+struct AdaptadorLista {
+    Lista<T> c;
+    static const char* nombre() { return "Lista"; }
+    static const bool frenteO1 = true, finalO1 = false, accesoO1 = false;
+    void llenar(size_t n) { for (size_t i = 0; i < n; i++) c.insertar_inicio(valorPrueba<T>(i)); }
+    void insertarInicio(const T& v) { c.insertar_inicio(v); }
+    void insertarFinal(const T& v) { c.insertar_final(v); }
+    void insertarEn(size_t pos, const T& v) { c.insertar_pos(v, (int)pos); }
+    T obtener(size_t pos) { return c.obtenerDato((int)pos); }
+    void modificar(size_t pos, const T& v) { c.modificar((int)pos, v); }
+    void eliminarEn(size_t pos) { c.eliminar((int)pos); }
+    size_t tam() { return (size_t)c.getTam(); }
+    void vaciar() { c.vaciar_lista(); }
+    // La única forma de recorrer es por posición: O(n) por elemento
+    static const bool recorridoCuadratico = true;
+    template <class F> void recorrer(size_t hasta, F f) { for (size_t i = 0; i < hasta; i++) f(c.obtenerDato((int)i)); }
+};
+
+template <class T>
+struct AdaptadorListaDoble {
+    ListaDoble<T> c;
+    static const char* nombre() { return "ListaDoble"; }
+    static const bool frenteO1 = true, finalO1 = true, accesoO1 = false;
+    void llenar(size_t n) { for (size_t i = 0; i < n; i++) c.insertar_final(valorPrueba<T>(i)); }
+    void insertarInicio(const T& v) { c.insertar_inicio(v); }
+    void insertarFinal(const T& v) { c.insertar_final(v); }
+    void insertarEn(size_t pos, const T& v) { c.insertar_pos(v, (int)pos); }
+    T obtener(size_t pos) { return c.obtenerDato((int)pos); }
+    void modificar(size_t pos, const T& v) { c.modificar((int)pos, v); }
+    void eliminarEn(size_t pos) { c.eliminar((int)pos); }
+    size_t tam() { return (size_t)c.getTam(); }
+    void vaciar() { c.vaciar_lista(); }
+    static const bool recorridoCuadratico = true;
+    template <class F> void recorrer(size_t hasta, F f) { for (size_t i = 0; i < hasta; i++) f(c.obtenerDato((int)i)); }
+};
+
+// std::list, std::deque y std::vector comparten la interfaz de secuencia
+template <class C, bool FRENTE_O1, bool ACCESO_O1>
+struct AdaptadorSecuencia {
+    typedef typename C::value_type T;
+    C c;
+    static const bool frenteO1 = FRENTE_O1, finalO1 = true, accesoO1 = ACCESO_O1;
+    void llenar(size_t n) { for (size_t i = 0; i < n; i++) c.push_back(valorPrueba<T>(i)); }
+    void insertarInicio(const T& v) { c.insert(c.begin(), v); }
+    void insertarFinal(const T& v) { c.push_back(v); }
+    void insertarEn(size_t pos, const T& v) { c.insert(next(c.begin(), pos), v); }
+    T obtener(size_t pos) { return *next(c.begin(), pos); }
+    void modificar(size_t pos, const T& v) { *next(c.begin(), pos) = v; }
+    void eliminarEn(size_t pos) { c.erase(next(c.begin(), pos)); }
+    size_t tam() { return c.size(); }
+    void vaciar() { c.clear(); }
+    static const bool recorridoCuadratico = false;
+    template <class F> void recorrer(size_t, F f) { for (typename C::iterator it = c.begin(); it != c.end(); ++it) f(*it); }
+};
+
+template <class T> struct AdaptadorStdList : AdaptadorSecuencia<list<T>, true, false> {
+    static const char* nombre() { return "std::list"; }
+};
+template <class T> struct AdaptadorDeque : AdaptadorSecuencia<deque<T>, true, true> {
+    static const char* nombre() { return "std::deque"; }
+};
+template <class T> struct AdaptadorVector : AdaptadorSecuencia<vector<T>, false, true> {
+    static const char* nombre() { return "std::vector"; }
+};
+
+// std::forward_list solo avanza: guardamos el último para insertar al final
+template <class T>
+struct AdaptadorForwardList {
+    forward_list<T> c;
+    typename forward_list<T>::iterator ultimo;
+    size_t n;
+    AdaptadorForwardList() : ultimo(c.before_begin()), n(0) {}
+    static const char* nombre() { return "std::forward_list"; }
+    static const bool frenteO1 = true, finalO1 = true, accesoO1 = false;
+    void llenar(size_t k) { for (size_t i = 0; i < k; i++) insertarFinal(valorPrueba<T>(i)); }
+    void insertarInicio(const T& v) {
+        c.push_front(v);
+        if (n++ == 0) ultimo = c.begin();
+    }
+    void insertarFinal(const T& v) {
+        ultimo = c.insert_after(ultimo, v);
+        n++;
+    }
+    void insertarEn(size_t pos, const T& v) {
+        if (pos == n) { insertarFinal(v); return; }
+        c.insert_after(next(c.before_begin(), pos), v);
+        n++;
+    }
+    T obtener(size_t pos) { return *next(c.begin(), pos); }
+    void modificar(size_t pos, const T& v) { *next(c.begin(), pos) = v; }
+    void eliminarEn(size_t pos) {
+        typename forward_list<T>::iterator antes = next(c.before_begin(), pos);
+        c.erase_after(antes);
+        if (--n == 0 || pos == n) ultimo = antes;
+    }
+    size_t tam() { return n; }
+    void vaciar() { c.clear(); ultimo = c.before_begin(); n = 0; }
+    static const bool recorridoCuadratico = false;
+    template <class F> void recorrer(size_t, F f) { for (typename forward_list<T>::iterator it = c.begin(); it != c.end(); ++it) f(*it); }
+};
+
+// -----------------------------------------------------
+// Resultados
+// -----------------------------------------------------
+struct Fila {
+    string contenedor, tipo, operacion;
+    size_t n, ops;
+    double nsOp, reservasOp;
+    long picoKB;
+};
+
+struct Parametros {
+    size_t minN, maxN;
+    double maxVisitas;
+    bool json;
+};
+
+class Medidor {
+private:
+    uint64_t t0;
+    long long r0;
+    Fila fila;
+
+public:
+    Medidor(const char* contenedor, const char* tipo, const char* operacion, size_t n) {
+        fila.contenedor = contenedor;
+        fila.tipo = tipo;
+        fila.operacion = operacion;
+        fila.n = n;
+        r0 = contadorMemoria().reservasActuales();
+        t0 = ahoraNs();
+    }
+    Fila terminar(size_t ops) {
+        uint64_t t = ahoraNs() - t0;
+        long long r = contadorMemoria().reservasActuales() - r0;
+        fila.ops = ops;
+        fila.nsOp = ops ? (double)t / ops : 0;
+        fila.reservasOp = ops ? (double)r / ops : 0;
+        fila.picoKB = picoMemoriaActualKB();
+        return fila;
+    }
+};
+
+// Repeticiones que caben en el presupuesto para una operación de costo O(n)
+inline size_t repeticiones(bool o1, size_t n, const Parametros& p) {
+    if (o1) return n;
+    size_t k = (size_t)(p.maxVisitas / (n > 0 ? n : 1));
+    if (k < 1) k = 1;
+    return k < n ? k : n;
+}
+
+// -----------------------------------------------------
+// Medición de un contenedor para un tamaño n
+// -----------------------------------------------------
+template <template <class> class Adaptador, class T>
+void medirContenedor(size_t n, const Parametros& p, vector<Fila>& filas) {
+    typedef Adaptador<T> A;
+    const char* tipo = nombreTipo<T>();
+    mt19937_64 motor(n);
+    T v = valorPrueba<T>(7);
+
+    reiniciarPicoMemoria();
+    A a;
+    a.llenar(n);
+
+    size_t k = repeticiones(A::frenteO1, n, p);
+    Medidor m1(A::nombre(), tipo, "insertar_inicio", n);
+    for (size_t i = 0; i < k; i++) a.insertarInicio(v);
+    filas.push_back(m1.terminar(k));
+    for (size_t i = 0; i < k; i++) a.eliminarEn(0);
+
+    k = repeticiones(A::finalO1, n, p);
+    Medidor m2(A::nombre(), tipo, "insertar_final", n);
+    for (size_t i = 0; i < k; i++) a.insertarFinal(v);
+    filas.push_back(m2.terminar(k));
+    // Retiramos lo agregado desde el frente (mismo contenido, costo O(1) en listas)
+    for (size_t i = 0; i < k; i++) a.eliminarEn(0);
+
+    k = repeticiones(false, n, p);
+    Medidor m3(A::nombre(), tipo, "insertar_medio", n);
+    for (size_t i = 0; i < k; i++) a.insertarEn(a.tam() / 2, v);
+    filas.push_back(m3.terminar(k));
+    for (size_t i = 0; i < k; i++) a.eliminarEn(0);
+
+    vector<size_t> posiciones(repeticiones(A::accesoO1, n, p));
+    for (size_t i = 0; i < posiciones.size(); i++) posiciones[i] = (size_t)(motor() % n);
+
+    Medidor m4(A::nombre(), tipo, "obtener", n);
+    for (size_t i = 0; i < posiciones.size(); i++) {
+        T dato = a.obtener(posiciones[i]);
+        noOptimizar(dato);
+    }
+    filas.push_back(m4.terminar(posiciones.size()));
+
+    Medidor m5(A::nombre(), tipo, "modificar", n);
+    for (size_t i = 0; i < posiciones.size(); i++) a.modificar(posiciones[i], v);
+    filas.push_back(m5.terminar(posiciones.size()));
+
+    // Recorrido completo; por posición solo cabe un prefijo de m elementos (m^2/2 visitas)
+    size_t m = n;
+    if (A::recorridoCuadratico) {
+        double limite = sqrt(2.0 * p.maxVisitas);
+        if (m > limite) m = (size_t)limite;
+    }
+    size_t vistos = 0;
+    Medidor m6(A::nombre(), tipo, "recorrer", n);
+    a.recorrer(m, [&](const T& dato) { noOptimizar(dato); vistos++; });
+    filas.push_back(m6.terminar(vistos));
+
+    k = repeticiones(false, n, p);
+    if (k > n / 2) k = n / 2;
+    Medidor m7(A::nombre(), tipo, "eliminar", n);
+    for (size_t i = 0; i < k; i++) a.eliminarEn((size_t)(motor() % a.tam()));
+    filas.push_back(m7.terminar(k));
+
+    size_t restantes = a.tam();
+    Medidor m8(A::nombre(), tipo, "vaciar", n);
+    a.vaciar();
+    filas.push_back(m8.terminar(restantes));
+}
+
+template <class T>
+void medirTipo(const Parametros& p, vector<Fila>& filas) {
+    for (size_t n = p.minN; n <= p.maxN; n *= 10) {
+        medirContenedor<AdaptadorLista, T>(n, p, filas);
+        medirContenedor<AdaptadorListaDoble, T>(n, p, filas);
+        medirContenedor<AdaptadorStdList, T>(n, p, filas);
+        medirContenedor<AdaptadorForwardList, T>(n, p, filas);
+        medirContenedor<AdaptadorDeque, T>(n, p, filas);
+        medirContenedor<AdaptadorVector, T>(n, p, filas);
+        cerr << nombreTipo<T>() << " n=" << n << " listo\n";
+    }
+}
+
+// -----------------------------------------------------
+// Salida
+// -----------------------------------------------------
+void imprimirCSV(ostream& salida, const vector<Fila>& filas) {
+    salida << "contenedor,tipo,n,operacion,ops,ns_op,reservas_op,pico_rss_kb\n";
+    for (size_t i = 0; i < filas.size(); i++) {
+        const Fila& f = filas[i];
+        salida << f.contenedor << ',' << f.tipo << ',' << f.n << ',' << f.operacion << ','
+               << f.ops << ',' << f.nsOp << ',' << f.reservasOp << ',' << f.picoKB << '\n';
+    }
+}
+
+void imprimirJSON(ostream& salida, const vector<Fila>& filas) {
+    salida << "[\n";
+    for (size_t i = 0; i < filas.size(); i++) {
+        const Fila& f = filas[i];
+        salida << "  {\"contenedor\": \"" << f.contenedor << "\", \"tipo\": \"" << f.tipo
+               << "\", \"n\": " << f.n << ", \"operacion\": \"" << f.operacion
+               << "\", \"ops\": " << f.ops << ", \"ns_op\": " << f.nsOp
+               << ", \"reservas_op\": " << f.reservasOp << ", \"pico_rss_kb\": " << f.picoKB
+               << (i + 1 < filas.size() ? "},\n" : "}\n");
+    }
+    salida << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    Parametros p;
+    p.minN = 100;
+    p.maxN = 1000000;
+    p.maxVisitas = 5e7;
+    p.json = false;
+    string tipos = "int,float,char,Persona";
+
+    if (const char* v = valorOpcion(argc, argv, "--min-n")) p.minN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-n")) p.maxN = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-visitas")) p.maxVisitas = atof(v);
+    if (const char* v = valorOpcion(argc, argv, "--formato")) p.json = string(v) == "json";
+    if (const char* v = valorOpcion(argc, argv, "--tipos")) tipos = v;
+    if (p.minN == 0) p.minN = 1;
+
+    vector<Fila> filas;
+    stringstream ss(tipos);
+    string tipo;
+    while (getline(ss, tipo, ',')) {
+        if (tipo == "int") medirTipo<int>(p, filas);
+        else if (tipo == "float") medirTipo<float>(p, filas);
+        else if (tipo == "char") medirTipo<char>(p, filas);
+        else if (tipo == "Persona") medirTipo<Persona>(p, filas);
+        else {
+            cerr << "Tipo desconocido: " << tipo << "\n";
+            return 1;
+        }
+    }
+
+    if (p.json) imprimirJSON(cout, filas);
+    else imprimirCSV(cout, filas);
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// ArbolRojiNegro<int, int> frente a ArbolBMas<int, int> con la misma carga:
+// - insertar: n claves distintas en orden aleatorio
+// - buscar: --consultas búsquedas de claves presentes (uniforme o zipf)
+// - rango: --rangos consultas de --ancho claves consecutivas, sumando las
+//   informaciones (iteradores de rango() en un motor, hojas enlazadas en el
+//   otro)
+// - eliminar: la mitad de las claves, en otro orden aleatorio
+//
+// Cada fase se mide sobre el árbol que dejó la anterior y los dos motores
+// deben devolver las mismas sumas.
+//
+// Uso:
+//     bench_motores [--n 1000000] [--consultas 2000000] [--rangos 100000]
+//                   [--ancho 100] [--distribucion uniforme|zipf|secuencial]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+#include "../../BPlus Tree/Files/ArbolBMas.h"
+
+using namespace std;
+
+typedef ArbolRojiNegro<int, int> ArbolRN;
+typedef ArbolBMas<int, int> ArbolBM;
+
+struct Carga {
+    vector<int> claves;    // orden de inserción
+    vector<int> consultas; // claves presentes
+    vector<int> desdes;    // inicio de cada rango
+    vector<int> borrar;    // la mitad de las claves
+    int ancho;
+};
+
+struct Fase {
+    const char* nombre;
+    size_t ops;
+    double segundos;
+    long long suma;
+};
+
+// Las consultas de rango, con iteradores o con el recorrido por hojas
+long long sumarRango(const ArbolRN& arbol, int a, int b) {
+    long long suma = 0;
+    ArbolRN::Rango r = arbol.rango(a, b);
+    for (ArbolRN::iterador it = r.begin(); it != r.end(); ++it) suma += it.info();
+    return suma;
+}
+
+long long sumarRango(const ArbolBM& arbol, int a, int b) {
+    long long suma = 0;
+    arbol.recorrerRango(a, b, [&](const int&, const int& info) { suma += info; });
+    return suma;
+}
+
+template <class Arbol>
+void medirMotor(const Carga& c, Fase fases[4]) {
+    Arbol arbol;
+    uint64_t inicio = ahoraNs();
+    for (size_t i = 0; i < c.claves.size(); i++) arbol.insertar(c.claves[i], c.claves[i] & 0xFFFF);
+    Fase insertar = { "insertar", c.claves.size(), (ahoraNs() - inicio) / 1e9, (long long)arbol.getTam() };
+    fases[0] = insertar;
+
+    Fase buscar = { "buscar", c.consultas.size(), 0, 0 };
+    inicio = ahoraNs();
+    for (size_t i = 0; i < c.consultas.size(); i++) {
+        if (const int* info = arbol.buscar(c.consultas[i])) buscar.suma += *info;
+    }
+    buscar.segundos = (ahoraNs() - inicio) / 1e9;
+    fases[1] = buscar;
+
+    // Las claves son múltiplos de 3 (ver main): cada rango tiene unas ancho claves
+    Fase rango = { "rango", c.desdes.size(), 0, 0 };
+    inicio = ahoraNs();
+    for (size_t i = 0; i < c.desdes.size(); i++)
+        rango.suma += sumarRango(arbol, c.desdes[i], c.desdes[i] + 3 * (c.ancho - 1));
+    rango.segundos = (ahoraNs() - inicio) / 1e9;
+    fases[2] = rango;
+
+    Fase eliminar = { "eliminar", c.borrar.size(), 0, 0 };
+    inicio = ahoraNs();
+    for (size_t i = 0; i < c.borrar.size(); i++) eliminar.suma += arbol.eliminar(c.borrar[i]) ? 1 : 0;
+    eliminar.segundos = (ahoraNs() - inicio) / 1e9;
+    fases[3] = eliminar;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 1000000, numConsultas = 2000000, numRangos = 100000;
+    Carga c;
+    c.ancho = 100;
+    Distribucion dist = DIST_UNIFORME;
+    if (const char* v = valorOpcion(argc, argv, "--n")) n = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--consultas")) numConsultas = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--rangos")) numRangos = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--ancho")) c.ancho = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--distribucion")) {
+        if (!leerDistribucion(v, dist)) {
+            cerr << "Distribución desconocida: " << v << "\n";
+            return 1;
+        }
+    }
+    if (n == 0) n = 1;
+    if (c.ancho < 1) c.ancho = 1;
+
+    // Claves 0, 3, 6... barajadas: distintas, y con huecos para que los
+    // bordes de los rangos no siempre coincidan con una clave
+    mt19937_64 motor(42);
+    c.claves.resize(n);
+    for (size_t i = 0; i < n; i++) c.claves[i] = (int)(3 * i);
+    shuffle(c.claves.begin(), c.claves.end(), motor);
+
+    GeneradorClaves generador(dist, n, 7);
+    c.consultas.resize(numConsultas);
+    for (size_t i = 0; i < numConsultas; i++) c.consultas[i] = c.claves[generador() % n];
+    c.desdes.resize(numRangos);
+    for (size_t i = 0; i < numRangos; i++) c.desdes[i] = (int)(motor() % (3 * n)) - 1;
+
+    c.borrar.assign(c.claves.begin(), c.claves.begin() + n / 2);
+    shuffle(c.borrar.begin(), c.borrar.end(), motor);
+
+    Fase rn[4], bm[4];
+    medirMotor<ArbolRN>(c, rn);
+    medirMotor<ArbolBM>(c, bm);
+    for (int i = 0; i < 4; i++) {
+        if (rn[i].suma != bm[i].suma) {
+            cerr << "Los motores no coinciden en " << rn[i].nombre << "\n";
+            return 1;
+        }
+    }
+
+    cout << "motor,fase,n,ops,segundos,ops_s\n";
+    for (int m = 0; m < 2; m++) {
+        const Fase* fases = m == 0 ? rn : bm;
+        for (int i = 0; i < 4; i++) {
+            const Fase& f = fases[i];
+            cout << (m == 0 ? "rojinegro" : "bmas") << ',' << f.nombre << ',' << n << ',' << f.ops << ','
+                 << f.segundos << ',' << (uint64_t)(f.segundos > 0 ? f.ops / f.segundos : 0) << '\n';
+        }
+    }
+    return 0;
+}
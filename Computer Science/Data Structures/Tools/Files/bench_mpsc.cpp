@@ -0,0 +1,136 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Banco de pruebas de ColaMPSC<T> frente a una ListaDoble<T> protegida con
+// un mutex, con 1 a 16 productores y un único consumidor.
+//
+// Cada productor inserta --elementos valores que codifican su número y una
+// secuencia; el consumidor los extrae todos y comprueba que no falte ninguno
+// y que los de cada productor lleguen en orden (FIFO por productor).
+//
+// Uso:
+//     bench_mpsc [--elementos 1000000] [--max-productores 16] [--repeticiones 3]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../Simple Linked List/Files/cola_mpsc.h"
+#include "../../Doubly Linked List/Files/lista_doble.h"
+
+using namespace std;
+
+static const int BITS_SECUENCIA = 40;
+
+// -----------------------------------------------------
+// Adaptadores: misma interfaz para las dos estructuras
+// -----------------------------------------------------
+struct AdaptadorColaMPSC {
+    ColaMPSC<uint64_t> cola;
+
+    static const char* nombre() { return "ColaMPSC"; }
+    void insertar(uint64_t v) { cola.insertar_final(v); }
+    bool extraer(uint64_t& v) { return cola.extraer_inicio(v); }
+};
+
+struct AdaptadorListaConMutex {
+    ListaDoble<uint64_t> lista;
+    mutex candado;
+
+    static const char* nombre() { return "ListaDoble+mutex"; }
+    void insertar(uint64_t v) {
+        lock_guard<mutex> guardia(candado);
+        lista.insertar_final(v);
+    }
+    bool extraer(uint64_t& v) {
+        lock_guard<mutex> guardia(candado);
+        if (lista.lista_vacia()) return false;
+        v = lista.obtenerDato(0);
+        lista.eliminar(0);
+        return true;
+    }
+};
+
+// -----------------------------------------------------
+// Una corrida: p productores, un consumidor (el hilo principal)
+// -----------------------------------------------------
+template <class Adaptador>
+double correr(int productores, uint64_t elementos, bool& correcto) {
+    Adaptador estructura;
+    atomic<bool> salida(false);
+    vector<thread> hilos;
+
+    for (int p = 0; p < productores; p++) {
+        hilos.push_back(thread([&estructura, &salida, p, elementos]() {
+            while (!salida.load(memory_order_acquire)) this_thread::yield();
+            uint64_t base = (uint64_t)p << BITS_SECUENCIA;
+            for (uint64_t i = 0; i < elementos; i++) estructura.insertar(base | i);
+        }));
+    }
+
+    vector<uint64_t> siguiente(productores, 0); // secuencia esperada de cada productor
+    uint64_t total = (uint64_t)productores * elementos;
+    uint64_t recibidos = 0;
+    correcto = true;
+
+    uint64_t inicio = ahoraNs();
+    salida.store(true, memory_order_release);
+    while (recibidos < total) {
+        uint64_t v;
+        if (!estructura.extraer(v)) continue;
+        int p = (int)(v >> BITS_SECUENCIA);
+        uint64_t secuencia = v & (((uint64_t)1 << BITS_SECUENCIA) - 1);
+        if (p >= productores || secuencia != siguiente[p]) correcto = false;
+        else siguiente[p]++;
+        recibidos++;
+    }
+    uint64_t fin = ahoraNs();
+
+    for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+    uint64_t sobrante;
+    if (estructura.extraer(sobrante)) correcto = false; // no debe quedar nada
+    return (fin - inicio) / 1e9;
+}
+
+template <class Adaptador>
+bool medir(int maxProductores, uint64_t elementos, int repeticiones) {
+    bool todoCorrecto = true;
+    for (int p = 1; p <= maxProductores; p *= 2) {
+        double mejor = 0;
+        for (int r = 0; r < repeticiones; r++) {
+            bool correcto;
+            double segundos = correr<Adaptador>(p, elementos, correcto);
+            if (!correcto) {
+                cerr << Adaptador::nombre() << ": orden o conteo incorrecto con " << p << " productores\n";
+                todoCorrecto = false;
+            }
+            if (r == 0 || segundos < mejor) mejor = segundos;
+        }
+        uint64_t total = (uint64_t)p * elementos;
+        cout << Adaptador::nombre() << ',' << p << ',' << total << ',' << mejor << ','
+             << (uint64_t)(mejor > 0 ? total / mejor : 0) << '\n';
+    }
+    return todoCorrecto;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t elementos = 1000000;
+    int maxProductores = 16;
+    int repeticiones = 3;
+
+    if (const char* v = valorOpcion(argc, argv, "--elementos")) elementos = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-productores")) maxProductores = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--repeticiones")) repeticiones = atoi(v);
+    if (maxProductores < 1) maxProductores = 1;
+    if (repeticiones < 1) repeticiones = 1;
+
+    cout << "estructura,productores,elementos,segundos,ops_s\n";
+    bool correcto = medir<AdaptadorColaMPSC>(maxProductores, elementos, repeticiones);
+    correcto = medir<AdaptadorListaConMutex>(maxProductores, elementos, repeticiones) && correcto;
+    return correcto ? 0 : 1;
+}
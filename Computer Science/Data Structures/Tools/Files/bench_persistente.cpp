@@ -0,0 +1,390 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// ArbolPersistente<int, int> en tres partes.
+//
+// 1. Prueba diferencial: --lotes lotes de --ops-lote operaciones al azar
+//    (insertar, eliminar, modificar, buscar) sobre un universo chico de
+//    claves, con repetidas, comparadas con un std::multimap. Cada operación
+//    usa al azar la versión que se conserva (const &) o la que se descarta
+//    (&&, con move). De vez en cuando se guarda una instantánea junto con
+//    una copia del multimap; al final de cada lote todas las instantáneas
+//    guardadas deben seguir iguales a su copia (clave e información, en
+//    orden): ninguna operación posterior, ni las que cambian nodos en el
+//    lugar, puede haberlas tocado.
+//
+// 2. Prueba con hilos: un escritor produce --versiones versiones con move
+//    mientras --lectores hilos toman instantáneas de la versión actual
+//    (copiándola bajo un mutex) y las recorren dos veces. Cada recorrido
+//    debe estar en orden, tener getTam() claves con información igual a la
+//    clave, y los dos recorridos deben coincidir. Conviene correrla también
+//    compilada con -fsanitize=thread.
+//
+// 3. Medición: n inserciones en orden aleatorio, n búsquedas y n / 2
+//    eliminaciones en ArbolRojiNegro y en ArbolPersistente, este último
+//    conservando cada versión (const &), descartándola (&&) y descartándola
+//    pero guardando una instantánea cada --cada operaciones.
+//
+// Ante cualquier diferencia el programa termina con 1.
+//
+// Uso:
+//     bench_persistente [--lotes 100] [--ops-lote 1000] [--universo 64]
+//                       [--semilla 42] [--lectores 4] [--versiones 20000]
+//                       [--n 1000000] [--cada 1000]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+#include "../../RedBlack Tree/Files/ArbolPersistente.h"
+
+using namespace std;
+
+typedef ArbolPersistente<int, int> Version;
+typedef multimap<int, int> Modelo;
+
+// -----------------------------------------------------
+// Prueba diferencial
+// -----------------------------------------------------
+
+vector<pair<int, int> > contenido(const Version& v) {
+    vector<pair<int, int> > resultado;
+    v.recorrerInorden([&](const int& clave, const int& info) { resultado.push_back(make_pair(clave, info)); });
+    return resultado;
+}
+
+vector<pair<int, int> > contenido(const Modelo& m) {
+    return vector<pair<int, int> >(m.begin(), m.end());
+}
+
+// Informaciones de clave, ordenadas
+vector<int> infos(const Version& v, int clave) {
+    vector<int> resultado;
+    v.recorrerInorden([&](const int& c, const int& info) { if (c == clave) resultado.push_back(info); });
+    sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+vector<int> infos(const Modelo& m, int clave) {
+    vector<int> resultado;
+    pair<Modelo::const_iterator, Modelo::const_iterator> r = m.equal_range(clave);
+    for (Modelo::const_iterator it = r.first; it != r.second; ++it) resultado.push_back(it->second);
+    sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+// La información que está en antes y ya no en despues (-1 si no hay una sola)
+int perdida(const vector<int>& antes, const vector<int>& despues) {
+    vector<int> diferencia;
+    set_difference(antes.begin(), antes.end(), despues.begin(), despues.end(), back_inserter(diferencia));
+    return diferencia.size() == 1 ? diferencia[0] : -1;
+}
+
+// Una operación al azar sobre actual. Devuelve false y deja en error la diferencia
+bool operacionAlAzar(Version& actual, Modelo& modelo, mt19937_64& motor, int universo,
+                     int& siguienteInfo, string& error) {
+    int clave = (int)(motor() % universo);
+    unsigned tipo = (unsigned)(motor() % 100);
+    bool mover = motor() % 2 == 0;
+    ostringstream op;
+    vector<int> antes = infos(modelo, clave);
+
+    if (tipo < 33) {
+        op << (mover ? "move(v)." : "v.") << "insertar(" << clave << ", " << siguienteInfo << ")";
+        actual = mover ? move(actual).insertar(clave, siguienteInfo) : actual.insertar(clave, siguienteInfo);
+        modelo.insert(make_pair(clave, siguienteInfo));
+        siguienteInfo++;
+        if (infos(actual, clave) != infos(modelo, clave)) error = "la clave no quedó con sus informaciones";
+
+    } else if (tipo < 66) {
+        op << (mover ? "move(v)." : "v.") << "eliminar(" << clave << ")";
+        actual = mover ? move(actual).eliminar(clave) : actual.eliminar(clave);
+        vector<int> despues = infos(actual, clave);
+        if (antes.empty()) {
+            if (!despues.empty()) error = "apareció una clave ausente";
+        } else {
+            int info = perdida(antes, despues);
+            if (info < 0 || despues.size() != antes.size() - 1) {
+                error = "no quitó exactamente una de las repetidas";
+            } else {
+                pair<Modelo::iterator, Modelo::iterator> r = modelo.equal_range(clave);
+                for (Modelo::iterator it = r.first; it != r.second; ++it) {
+                    if (it->second == info) {
+                        modelo.erase(it);
+                        break;
+                    }
+                }
+            }
+        }
+
+    } else if (tipo < 85) {
+        op << (mover ? "move(v)." : "v.") << "modificar(" << clave << ", " << siguienteInfo << ")";
+        actual = mover ? move(actual).modificar(clave, siguienteInfo) : actual.modificar(clave, siguienteInfo);
+        vector<int> despues = infos(actual, clave);
+        if (antes.empty()) {
+            if (!despues.empty()) error = "apareció una clave ausente";
+        } else {
+            int info = perdida(antes, despues);
+            if (info < 0 || despues.size() != antes.size() ||
+                !binary_search(despues.begin(), despues.end(), siguienteInfo)) {
+                error = "no cambió exactamente una de las repetidas";
+            } else {
+                pair<Modelo::iterator, Modelo::iterator> r = modelo.equal_range(clave);
+                for (Modelo::iterator it = r.first; it != r.second; ++it)
+                    if (it->second == info) it->second = siguienteInfo;
+            }
+        }
+        siguienteInfo++;
+
+    } else {
+        op << "buscar(" << clave << ")";
+        const int* info = actual.buscar(clave);
+        if ((info == nullptr) != antes.empty() || actual.contiene(clave) != !antes.empty())
+            error = info == nullptr ? "no encontró una clave presente" : "encontró una clave ausente";
+        else if (info != nullptr && !binary_search(antes.begin(), antes.end(), *info))
+            error = "devolvió una información que la clave no tiene";
+    }
+
+    if (error.empty() && actual.getTam() != modelo.size()) error = "getTam no coincide con el multimap";
+    if (error.empty()) return true;
+    error = op.str() + ": " + error;
+    return false;
+}
+
+bool pruebaDiferencial(size_t lotes, size_t opsLote, int universo, uint64_t semilla) {
+    if (lotes == 0) return true;
+    mt19937_64 motor(semilla);
+    Version actual;
+    Modelo modelo;
+    vector<pair<Version, Modelo> > guardadas; // instantáneas y lo que deben contener
+    int siguienteInfo = 0;
+    string error;
+    for (size_t l = 0; l < lotes; l++) {
+        for (size_t i = 0; i < opsLote; i++) {
+            if (!operacionAlAzar(actual, modelo, motor, universo, siguienteInfo, error)) {
+                cerr << "Diferencia con semilla " << semilla << ", lote " << l << ", operación " << i
+                     << ": " << error << "\n";
+                return false;
+            }
+            if (motor() % 50 == 0) {
+                guardadas.push_back(make_pair(actual.instantanea(), modelo));
+                if (guardadas.size() > 32) guardadas.erase(guardadas.begin()); // suelta la más vieja
+            }
+        }
+        if (contenido(actual) != contenido(modelo)) {
+            cerr << "Diferencia con semilla " << semilla << " al final del lote " << l
+                 << ": el inorden no coincide con el multimap\n";
+            return false;
+        }
+        for (size_t g = 0; g < guardadas.size(); g++) {
+            if (contenido(guardadas[g].first) != contenido(guardadas[g].second)) {
+                cerr << "Diferencia con semilla " << semilla << " al final del lote " << l
+                     << ": una instantánea guardada cambió\n";
+                return false;
+            }
+        }
+    }
+    cerr << "Prueba diferencial: " << lotes * opsLote << " operaciones en " << lotes
+         << " lotes, sin diferencias (" << actual.getTam() << " claves al final)\n";
+    return true;
+}
+
+// -----------------------------------------------------
+// Prueba con hilos
+// -----------------------------------------------------
+
+// Recorre v y comprueba orden, tamaño e información == clave. Devuelve una
+// suma del contenido, o -1 si algo no cuadra
+long long recorrerYComprobar(const Version& v) {
+    long long suma = 0;
+    size_t cuenta = 0;
+    int anterior = -1;
+    bool bien = true;
+    v.recorrerInorden([&](const int& clave, const int& info) {
+        if (clave < anterior || info != clave) bien = false;
+        anterior = clave;
+        suma += 31 * (long long)clave + 7;
+        cuenta++;
+    });
+    return bien && cuenta == v.getTam() ? suma : -1;
+}
+
+bool pruebaHilos(unsigned lectores, size_t versiones, uint64_t semilla) {
+    if (lectores == 0 || versiones == 0) return true;
+    mutex candado;
+    Version actual;
+    atomic<bool> fin(false), falla(false);
+    atomic<long long> instantaneas(0);
+
+    vector<thread> hilos;
+    for (unsigned h = 0; h < lectores; h++) {
+        hilos.push_back(thread([&]() {
+            while (!fin.load(memory_order_acquire)) {
+                Version foto;
+                {
+                    lock_guard<mutex> g(candado);
+                    foto = actual; // O(1)
+                }
+                long long primera = recorrerYComprobar(foto);
+                this_thread::yield(); // el escritor sigue cambiando la versión actual
+                if (primera < 0 || recorrerYComprobar(foto) != primera) falla.store(true);
+                instantaneas.fetch_add(1, memory_order_relaxed);
+            }
+        }));
+    }
+
+    // El escritor trabaja sobre su propia variable y publica cada versión;
+    // move(v) cambia en el lugar los nodos que ninguna instantánea comparte
+    mt19937_64 motor(semilla);
+    Version propia;
+    for (size_t i = 0; i < versiones; i++) {
+        int clave = (int)(motor() % 4096);
+        switch (motor() % 3) {
+            case 0: propia = move(propia).insertar(clave, clave); break;
+            case 1: propia = move(propia).eliminar(clave); break;
+            default: propia = move(propia).modificar(clave, clave); break;
+        }
+        lock_guard<mutex> g(candado);
+        actual = propia;
+    }
+    fin.store(true, memory_order_release);
+    for (size_t h = 0; h < hilos.size(); h++) hilos[h].join();
+
+    if (falla.load() || recorrerYComprobar(propia) < 0) {
+        cerr << "Prueba con hilos: un lector vio una instantánea que cambió o estaba rota\n";
+        return false;
+    }
+    cerr << "Prueba con hilos: " << versiones << " versiones, " << lectores << " lectores, "
+         << instantaneas.load() << " instantáneas recorridas dos veces, correcto\n";
+    return true;
+}
+
+// -----------------------------------------------------
+// Medición
+// -----------------------------------------------------
+
+struct Fase {
+    string estructura;
+    const char* nombre;
+    size_t ops;
+    double segundos;
+    long long suma; // para comparar las estructuras
+};
+
+void reportar(const Fase& f, size_t n) {
+    cout << f.estructura << ',' << f.nombre << ',' << n << ',' << f.ops << ',' << f.segundos << ','
+         << (uint64_t)(f.segundos > 0 ? f.ops / f.segundos : 0) << '\n';
+}
+
+template <class F>
+Fase medir(const string& estructura, const char* nombre, size_t ops, F f) {
+    Fase fase = { estructura, nombre, ops, 0, 0 };
+    uint64_t inicio = ahoraNs();
+    fase.suma = f();
+    fase.segundos = (ahoraNs() - inicio) / 1e9;
+    return fase;
+}
+
+// modo: 0 = conserva cada versión (const &), 1 = move, 2 = move con una
+// instantánea cada 'cada' operaciones
+void medirPersistente(int modo, size_t cada, const vector<int>& claves, const vector<int>& consultas,
+                      const vector<int>& borrar, vector<Fase>& fases) {
+    static const char* nombres[] = { "persistente", "persistente_move", "persistente_move_instantaneas" };
+    Version v, foto;
+    size_t n = claves.size();
+    fases.push_back(medir(nombres[modo], "insertar", n, [&]() {
+        for (size_t i = 0; i < n; i++) {
+            if (modo == 0) v = v.insertar(claves[i], claves[i] & 0xFFFF);
+            else v = move(v).insertar(claves[i], claves[i] & 0xFFFF);
+            if (modo == 2 && i % cada == 0) foto = v;
+        }
+        return (long long)v.getTam();
+    }));
+    fases.push_back(medir(nombres[modo], "buscar", consultas.size(), [&]() {
+        long long suma = 0;
+        for (size_t i = 0; i < consultas.size(); i++)
+            if (const int* info = v.buscar(consultas[i])) suma += *info;
+        return suma;
+    }));
+    fases.push_back(medir(nombres[modo], "eliminar", borrar.size(), [&]() {
+        for (size_t i = 0; i < borrar.size(); i++) {
+            if (modo == 0) v = v.eliminar(borrar[i]);
+            else v = move(v).eliminar(borrar[i]);
+            if (modo == 2 && i % cada == 0) foto = v;
+        }
+        return (long long)v.getTam();
+    }));
+}
+
+int main(int argc, char* argv[]) {
+    size_t lotes = 100, opsLote = 1000, versiones = 20000, n = 1000000, cada = 1000;
+    int universo = 64;
+    unsigned lectores = 4;
+    uint64_t semilla = 42;
+    if (const char* v = valorOpcion(argc, argv, "--lotes")) lotes = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--ops-lote")) opsLote = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--universo")) universo = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--semilla")) semilla = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--lectores")) lectores = atoi(v);
+    if (const char* v = valorOpcion(argc, argv, "--versiones")) versiones = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--n")) n = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--cada")) cada = strtoull(v, NULL, 10);
+    if (universo < 1) universo = 1;
+    if (cada == 0) cada = 1;
+
+    if (!pruebaDiferencial(lotes, opsLote, universo, semilla)) return 1;
+    if (!pruebaHilos(lectores, versiones, semilla)) return 1;
+    if (n == 0) return 0;
+
+    mt19937_64 motor(semilla);
+    vector<int> claves(n);
+    for (size_t i = 0; i < n; i++) claves[i] = (int)i;
+    shuffle(claves.begin(), claves.end(), motor);
+    vector<int> consultas(claves);
+    shuffle(consultas.begin(), consultas.end(), motor);
+    vector<int> borrar(claves.begin(), claves.begin() + n / 2);
+    shuffle(borrar.begin(), borrar.end(), motor);
+
+    vector<Fase> fases;
+    {
+        ArbolRojiNegro<int, int> arbol;
+        fases.push_back(medir("rojinegro", "insertar", n, [&]() {
+            for (size_t i = 0; i < n; i++) arbol.insertar(claves[i], claves[i] & 0xFFFF);
+            return (long long)arbol.getTam();
+        }));
+        fases.push_back(medir("rojinegro", "buscar", n, [&]() {
+            long long suma = 0;
+            for (size_t i = 0; i < n; i++)
+                if (const int* info = arbol.buscar(consultas[i])) suma += *info;
+            return suma;
+        }));
+        fases.push_back(medir("rojinegro", "eliminar", borrar.size(), [&]() {
+            for (size_t i = 0; i < borrar.size(); i++) arbol.eliminar(borrar[i]);
+            return (long long)arbol.getTam();
+        }));
+    }
+    for (int modo = 0; modo < 3; modo++) medirPersistente(modo, cada, claves, consultas, borrar, fases);
+
+    for (size_t i = 3; i < fases.size(); i++) {
+        if (fases[i].suma != fases[i % 3].suma) {
+            cerr << fases[i].estructura << " no coincide con rojinegro en " << fases[i].nombre << "\n";
+            return 1;
+        }
+    }
+    cout << "estructura,fase,n,ops,segundos,ops_s\n";
+    for (size_t i = 0; i < fases.size(); i++) reportar(fases[i], n);
+    return 0;
+}
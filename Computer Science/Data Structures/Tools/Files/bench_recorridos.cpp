@@ -0,0 +1,98 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Exportación de todas las claves de ArbolRojiNegro en los cuatro órdenes.
+// Compara las colas que devuelven inorden(), preorden(), posorden() y
+// porNiveles() (hilos = 0 en el CSV) con exportarInorden... sobre un arreglo
+// reservado de antemano, con 1, 2, 4... hilos hasta --max-hilos. Cada
+// exportación se compara con la cola antes de reportarla.
+//
+// El árbol se arma con inserciones en orden aleatorio, para que los nodos
+// queden repartidos en memoria como en un árbol que creció con el uso.
+//
+// Uso:
+//     bench_recorridos [--n 2000000] [--max-hilos 8]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "pool_hilos.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+
+using namespace std;
+
+typedef ArbolRojiNegro<int, int> Arbol;
+
+enum Orden { INORDEN, PREORDEN, POSORDEN, POR_NIVELES };
+const char* NOMBRES[] = { "inorden", "preorden", "posorden", "porNiveles" };
+
+queue<int> cola(Arbol& arbol, Orden orden) {
+    switch (orden) {
+        case INORDEN: return arbol.inorden();
+        case PREORDEN: return arbol.preorden();
+        case POSORDEN: return arbol.posorden();
+        default: return arbol.porNiveles();
+    }
+}
+
+template <class Ejecutor>
+void exportar(const Arbol& arbol, Orden orden, int* destino, Ejecutor& ejecutor) {
+    switch (orden) {
+        case INORDEN: arbol.exportarInorden(destino, ejecutor); break;
+        case PREORDEN: arbol.exportarPreorden(destino, ejecutor); break;
+        case POSORDEN: arbol.exportarPosorden(destino, ejecutor); break;
+        default: arbol.exportarPorNiveles(destino, ejecutor); break;
+    }
+}
+
+void reportar(Orden orden, size_t n, unsigned hilos, double segundos) {
+    cout << NOMBRES[orden] << ',' << n << ',' << hilos << ',' << segundos << ','
+         << (uint64_t)(segundos > 0 ? n / segundos : 0) << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 2000000;
+    unsigned maxHilos = 8;
+    if (const char* v = valorOpcion(argc, argv, "--n")) n = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-hilos")) maxHilos = atoi(v);
+    if (maxHilos == 0) maxHilos = 1;
+
+    mt19937_64 motor(42);
+    vector<int> claves(n);
+    for (size_t i = 0; i < n; i++) claves[i] = (int)i;
+    shuffle(claves.begin(), claves.end(), motor);
+    Arbol arbol;
+    for (size_t i = 0; i < n; i++) arbol.insertar(claves[i], 0);
+
+    vector<int> esperado(n), destino(n);
+    cout << "recorrido,n,hilos,segundos,claves_s\n";
+    for (int o = INORDEN; o <= POR_NIVELES; o++) {
+        Orden orden = (Orden)o;
+        uint64_t inicio = ahoraNs();
+        queue<int> q = cola(arbol, orden);
+        double segundos = (ahoraNs() - inicio) / 1e9;
+        for (size_t i = 0; i < n; i++, q.pop()) esperado[i] = q.front();
+        reportar(orden, n, 0, segundos);
+
+        for (unsigned h = 1; h <= maxHilos; h *= 2) {
+            PoolHilos pool(h);
+            fill(destino.begin(), destino.end(), -1);
+            inicio = ahoraNs();
+            exportar(arbol, orden, destino.data(), pool);
+            segundos = (ahoraNs() - inicio) / 1e9;
+            if (destino != esperado) {
+                cerr << NOMBRES[orden] << " con " << h << " hilos no coincide con la cola\n";
+                return 1;
+            }
+            reportar(orden, n, h, segundos);
+        }
+    }
+    return 0;
+}
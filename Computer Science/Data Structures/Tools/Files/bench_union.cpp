@@ -0,0 +1,115 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Operaciones de conjuntos de ArbolRojiNegro (unir, interseccion,
+// diferencia, insertarLote sobre unir/dividir) frente a hacer lo mismo clave
+// por clave con insertar/buscar/eliminar.
+//
+// Para cada m se arma un árbol grande de n claves aleatorias y uno chico de
+// m claves (la mitad de ellas también están en el grande) y se mide cada
+// operación con 1, 2, 4... hilos hasta --max-hilos, más la versión clave por
+// clave como referencia (hilos = 0 en el CSV).
+//
+// Uso:
+//     bench_union [--n 2000000] [--min-m 1000] [--max-hilos 8]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "lote.h"
+#include "medicion.h"
+#include "pool_hilos.h"
+#include "../../RedBlack Tree/Files/ArbolRojiNegro.h"
+
+using namespace std;
+
+typedef ArbolRojiNegro<int, int> Arbol;
+typedef vector<pair<int, int> > Pares;
+
+enum OperacionConjunto { UNIR, INTERSECCION, DIFERENCIA, INSERTAR_LOTE };
+const char* NOMBRES[] = { "unir", "interseccion", "diferencia", "insertarLote" };
+
+// Segundos de la operación con el ejecutor dado (sin contar la carga)
+template <class Ejecutor>
+double medir(OperacionConjunto op, const Pares& grande, const Pares& chico, Ejecutor& ejecutor) {
+    Arbol a, b;
+    a.insertarLote(grande);
+    if (op != INSERTAR_LOTE) b.insertarLote(chico);
+    uint64_t inicio = ahoraNs();
+    switch (op) {
+        case UNIR: a.unir(b, ejecutor); break;
+        case INTERSECCION: a.interseccion(b, ejecutor); break;
+        case DIFERENCIA: a.diferencia(b, ejecutor); break;
+        case INSERTAR_LOTE: a.insertarLote(chico, ejecutor); break;
+    }
+    return (ahoraNs() - inicio) / 1e9;
+}
+
+// Lo mismo clave por clave (con claves únicas dan el mismo resultado)
+double medirUnaAUna(OperacionConjunto op, const Pares& grande, const Pares& chico) {
+    Arbol a, b;
+    a.insertarLote(grande);
+    b.insertarLote(chico);
+    uint64_t inicio = ahoraNs();
+    switch (op) {
+        case UNIR:
+            for (size_t i = 0; i < chico.size(); i++) a.insertarOAsignar(chico[i].first, chico[i].second);
+            break;
+        case INTERSECCION: {
+            // recorrer el grande y quitar en el mismo recorrido lo que no está en el chico
+            for (Arbol::iterador it = a.begin(); it != a.end();) {
+                if (b.contar(*it, *it) == 0) it = a.eliminar(it);
+                else ++it;
+            }
+            break;
+        }
+        case DIFERENCIA:
+            for (size_t i = 0; i < chico.size(); i++) a.eliminar(chico[i].first);
+            break;
+        case INSERTAR_LOTE:
+            for (size_t i = 0; i < chico.size(); i++) a.insertar(chico[i].first, chico[i].second);
+            break;
+    }
+    return (ahoraNs() - inicio) / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = 2000000, minM = 1000;
+    unsigned maxHilos = 8;
+    if (const char* v = valorOpcion(argc, argv, "--n")) n = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--min-m")) minM = strtoull(v, NULL, 10);
+    if (const char* v = valorOpcion(argc, argv, "--max-hilos")) maxHilos = atoi(v);
+    if (minM == 0) minM = 1;
+    if (maxHilos == 0) maxHilos = 1;
+
+    // Claves únicas: las de la unión sin repetidos se comparan con insertarOAsignar
+    mt19937_64 motor(42);
+    vector<int> claves(2 * n);
+    for (size_t i = 0; i < claves.size(); i++) claves[i] = (int)i;
+    shuffle(claves.begin(), claves.end(), motor);
+    Pares grande(n);
+    for (size_t i = 0; i < n; i++) grande[i] = make_pair(claves[i], 0);
+
+    cout << "operacion,n,m,hilos,segundos\n";
+    for (size_t m = minM; m <= n; m *= 10) {
+        Pares chico(m);
+        for (size_t i = 0; i < m; i++) {
+            size_t j = i % 2 == 0 ? i : n + i; // mitad compartidas, mitad nuevas
+            chico[i] = make_pair(claves[j], 1);
+        }
+        for (int op = UNIR; op <= INSERTAR_LOTE; op++) {
+            OperacionConjunto o = (OperacionConjunto)op;
+            cout << NOMBRES[op] << ',' << n << ',' << m << ",0," << medirUnaAUna(o, grande, chico) << '\n';
+            for (unsigned h = 1; h <= maxHilos; h *= 2) {
+                PoolHilos pool(h);
+                cout << NOMBRES[op] << ',' << n << ',' << m << ',' << h << ',' << medir(o, grande, chico, pool) << '\n';
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Contador de reservas de memoria para los programas de medición.
+// Reemplaza los operadores globales new/delete, así que debe incluirse en
+// UN SOLO .cpp por programa (nunca en las cabeceras de las estructuras).
+
+#ifndef CONTADOR_MEMORIA_H
+#define CONTADOR_MEMORIA_H
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+struct ContadorMemoria {
+    atomic<long long> reservas;   // llamadas a new
+    atomic<long long> liberaciones;
+    atomic<long long> bytesVivos; // bytes pedidos y aún no liberados
+
+    long long reservasActuales() const { return reservas.load(memory_order_relaxed); }
+    long long bytesActuales() const { return bytesVivos.load(memory_order_relaxed); }
+};
+
+inline ContadorMemoria& contadorMemoria() {
+    static ContadorMemoria c; // inicialización estática a cero
+    return c;
+}
+
+// Cada bloque guarda su tamaño en una cabecera de 16 bytes para conservar
+// la alineación que garantiza malloc.
+static const size_t CABECERA_BLOQUE = 16;
+
+inline void* reservarContado(size_t tam) {
+    char* p = (char*)malloc(tam + CABECERA_BLOQUE);
+    if (p == NULL) throw bad_alloc();
+    *(size_t*)p = tam;
+    ContadorMemoria& c = contadorMemoria();
+    c.reservas.fetch_add(1, memory_order_relaxed);
+    c.bytesVivos.fetch_add((long long)tam, memory_order_relaxed);
+    return p + CABECERA_BLOQUE;
+}
+
+inline void liberarContado(void* ptr) {
+    if (ptr == NULL) return;
+    char* p = (char*)ptr - CABECERA_BLOQUE;
+    ContadorMemoria& c = contadorMemoria();
+    c.liberaciones.fetch_add(1, memory_order_relaxed);
+    c.bytesVivos.fetch_sub((long long)*(size_t*)p, memory_order_relaxed);
+    free(p);
+}
+
+void* operator new(size_t tam) { return reservarContado(tam); }
+void* operator new[](size_t tam) { return reservarContado(tam); }
+void operator delete(void* p) noexcept { liberarContado(p); }
+void operator delete[](void* p) noexcept { liberarContado(p); }
+void operator delete(void* p, size_t) noexcept { liberarContado(p); }
+void operator delete[](void* p, size_t) noexcept { liberarContado(p); }
+
+#endif
@@ -0,0 +1,165 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Recuperación de memoria basada en épocas (EBR) para las estructuras
+// concurrentes: un nodo desenlazado no se libera mientras algún lector que
+// pudo verlo siga dentro de su sección crítica.
+//
+// - Cada operación abre una GuardiaEpoca, que ocupa una ranura del dominio y
+//   anuncia en ella la época global que observó.
+// - retirar(p) guarda p en la lista de pendientes de la ranura junto con la
+//   época actual. Cada cierto número de retiros se intenta avanzar la época
+//   global (solo si todas las ranuras activas ya la anunciaron) y se liberan
+//   los pendientes con dos o más épocas de antigüedad: ningún lector puede
+//   seguir viéndolos.
+// - Las ranuras se toman con un CAS al abrir la guardia y se sueltan al
+//   cerrarla; los pendientes se quedan en la ranura para el siguiente dueño.
+//   Lo que quede al destruir el dominio se libera en el destructor.
+
+#ifndef EPOCAS_H
+#define EPOCAS_H
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+template <class U>
+void borrarObjeto(void* p) { delete (U*)p; }
+
+class DominioEpocas {
+public:
+    static const int MAX_RANURAS = 64;   // guardias abiertas a la vez
+    static const int RETIROS_POR_AVANCE = 64;
+
+private:
+    struct Retirado {
+        void* p;
+        void (*borrar)(void*);
+        uint64_t epoca;
+    };
+
+    // Cada ranura en su propia línea de caché: la escribe solo su dueño
+    struct alignas(64) Ranura {
+        atomic<bool> ocupada;
+        atomic<uint64_t> epoca;   // 0 = fuera de sección crítica
+        vector<Retirado> pendientes;
+        int retirosDesdeAvance;
+
+        Ranura() : ocupada(false), epoca(0), retirosDesdeAvance(0) {}
+    };
+
+    alignas(64) atomic<uint64_t> epocaGlobal;
+    Ranura ranuras[MAX_RANURAS];
+
+    // Avanza la época si todas las guardias activas ya anunciaron la actual
+    void intentarAvanzar() {
+        uint64_t e = epocaGlobal.load(memory_order_seq_cst);
+        for (int i = 0; i < MAX_RANURAS; i++) {
+            uint64_t anunciada = ranuras[i].epoca.load(memory_order_seq_cst);
+            if (anunciada != 0 && anunciada != e) return;
+        }
+        epocaGlobal.compare_exchange_strong(e, e + 1, memory_order_seq_cst);
+    }
+
+    // Libera los pendientes de la ranura con al menos dos épocas de antigüedad
+    void liberarViejos(Ranura& r) {
+        uint64_t e = epocaGlobal.load(memory_order_seq_cst);
+        size_t quedan = 0;
+        for (size_t i = 0; i < r.pendientes.size(); i++) {
+            if (r.pendientes[i].epoca + 2 <= e) r.pendientes[i].borrar(r.pendientes[i].p);
+            else r.pendientes[quedan++] = r.pendientes[i];
+        }
+        r.pendientes.resize(quedan);
+    }
+
+public:
+    DominioEpocas() : epocaGlobal(1) {}
+
+    // Sin guardias abiertas: todo lo pendiente ya se puede liberar
+    ~DominioEpocas() {
+        for (int i = 0; i < MAX_RANURAS; i++) {
+            vector<Retirado>& v = ranuras[i].pendientes;
+            for (size_t j = 0; j < v.size(); j++) v[j].borrar(v[j].p);
+        }
+    }
+
+    // Ocupa una ranura libre y anuncia la época actual
+    int entrar() {
+        static thread_local int pista = 0; // última ranura usada por este hilo
+        int i = pista;
+        while (true) {
+            bool libre = false;
+            if (!ranuras[i].ocupada.load(memory_order_relaxed) &&
+                ranuras[i].ocupada.compare_exchange_strong(libre, true, memory_order_acquire)) break;
+            if (++i == MAX_RANURAS) {
+                i = 0;
+                this_thread::yield(); // todas ocupadas: esperamos a que se suelte una
+            }
+        }
+        pista = i;
+        // El anuncio debe ser visible antes de leer cualquier nodo (seq_cst)
+        ranuras[i].epoca.store(epocaGlobal.load(memory_order_seq_cst), memory_order_seq_cst);
+        return i;
+    }
+
+    void salir(int ranura) {
+        ranuras[ranura].epoca.store(0, memory_order_release);
+        ranuras[ranura].ocupada.store(false, memory_order_release);
+    }
+
+    // p ya no es alcanzable desde la estructura; se liberará cuando sea seguro
+    void retirar(int ranura, void* p, void (*borrar)(void*)) {
+        Ranura& r = ranuras[ranura];
+        Retirado ret = { p, borrar, epocaGlobal.load(memory_order_seq_cst) };
+        r.pendientes.push_back(ret);
+        if (++r.retirosDesdeAvance >= RETIROS_POR_AVANCE) {
+            r.retirosDesdeAvance = 0;
+            intentarAvanzar();
+            liberarViejos(r);
+        }
+    }
+
+    // Período de gracia: vuelve cuando se cerraron todas las guardias que
+    // estaban abiertas al llamarla (las que se abran después no cuentan).
+    // La época avanza dos veces, y cada avance espera a que las guardias
+    // activas anuncien la época anterior. No se llama con una guardia propia
+    // abierta: esperaría a sí misma
+    void sincronizar() {
+        uint64_t meta = epocaGlobal.load(memory_order_seq_cst) + 2;
+        while (epocaGlobal.load(memory_order_seq_cst) < meta) {
+            intentarAvanzar();
+            if (epocaGlobal.load(memory_order_seq_cst) < meta) this_thread::yield();
+        }
+    }
+
+    uint64_t epocaActual() const { return epocaGlobal.load(memory_order_relaxed); }
+
+private:
+    DominioEpocas(const DominioEpocas&);            // no copiable
+    DominioEpocas& operator=(const DominioEpocas&);
+};
+
+// -----------------------------------------------------
+// Sección crítica de lectura/escritura (RAII)
+// -----------------------------------------------------
+class GuardiaEpoca {
+private:
+    DominioEpocas& dominio;
+    int ranura;
+
+public:
+    explicit GuardiaEpoca(DominioEpocas& d) : dominio(d), ranura(d.entrar()) {}
+    ~GuardiaEpoca() { dominio.salir(ranura); }
+
+    template <class U>
+    void retirar(U* p) { dominio.retirar(ranura, p, &borrarObjeto<U>); }
+
+private:
+    GuardiaEpoca(const GuardiaEpoca&);
+    GuardiaEpoca& operator=(const GuardiaEpoca&);
+};
+
+#endif
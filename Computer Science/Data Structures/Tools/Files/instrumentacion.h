@@ -0,0 +1,280 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Contadores de instrumentación para Lista<T>, ListaDoble<T> y
+// ArbolRojiNegro.
+//
+// Solo se incluye cuando se compila con -DLISTAS_INSTRUMENTADAS (listas) o
+// -DARBOL_INSTRUMENTADO (árbol). Cada familia de macros se define solo con
+// su bandera: con una sola activa, las macros de la otra estructura siguen
+// siendo las vacías de su cabecera y no cuestan nada. Los contadores son por hilo
+// (thread_local), así que el camino rápido no usa atómicos: cada hilo
+// consulta y vuelca los suyos.
+
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+#include <cstdint>
+#include <iostream>
+#include "medicion.h"
+
+using namespace std;
+
+// -----------------------------------------------------
+// Histograma en potencias de 2: la cubeta 0 cuenta el valor 0
+// y la cubeta i >= 1 cuenta los valores en [2^(i-1), 2^i)
+// -----------------------------------------------------
+struct HistogramaLog2 {
+    static const int CUBETAS = 33;
+    uint64_t cubetas[CUBETAS];
+    uint64_t llamadas;
+    uint64_t suma;
+
+    HistogramaLog2() { reiniciar(); }
+
+    void reiniciar() {
+        for (int i = 0; i < CUBETAS; i++) cubetas[i] = 0;
+        llamadas = suma = 0;
+    }
+
+    void registrar(uint64_t valor) {
+        int i = 0;
+        while (valor >> i && i < CUBETAS - 1) i++;
+        cubetas[i]++;
+        llamadas++;
+        suma += valor;
+    }
+
+    void combinar(const HistogramaLog2& otro) {
+        for (int i = 0; i < CUBETAS; i++) cubetas[i] += otro.cubetas[i];
+        llamadas += otro.llamadas;
+        suma += otro.suma;
+    }
+
+    // {"llamadas": n, "promedio": x, "cubetas": {"0": a, "1": b, "2-3": c, ...}}
+    void volcarJSON(ostream& salida) const {
+        salida << "{\"llamadas\": " << llamadas << ", \"promedio\": "
+               << (llamadas ? (double)suma / llamadas : 0.0) << ", \"cubetas\": {";
+        bool primera = true;
+        for (int i = 0; i < CUBETAS; i++) {
+            if (cubetas[i] == 0) continue;
+            uint64_t desde = i == 0 ? 0 : (uint64_t)1 << (i - 1);
+            uint64_t hasta = i == 0 ? 0 : ((uint64_t)1 << i) - 1;
+            salida << (primera ? "" : ", ") << "\"" << desde;
+            if (hasta != desde) salida << "-" << hasta;
+            salida << "\": " << cubetas[i];
+            primera = false;
+        }
+        salida << "}}";
+    }
+};
+
+// -----------------------------------------------------
+// Estadísticas de las listas
+// -----------------------------------------------------
+enum OperacionLista {
+    LISTA_OBTENER = 0, LISTA_MODIFICAR, LISTA_ELIMINAR, LISTA_INSERTAR_POS, LISTA_INSERTAR_FINAL,
+    LISTA_POSICION_ORDENADA,
+    NUM_OPERACIONES_LISTA
+};
+
+enum OperacionArchivo { ARCHIVO_CARGA = 0, ARCHIVO_GUARDADO, NUM_OPERACIONES_ARCHIVO };
+
+struct EstadisticasListas {
+    HistogramaLog2 nodosRecorridos[NUM_OPERACIONES_LISTA]; // enlaces seguidos por llamada
+    uint64_t reservas, liberaciones;                       // nodos creados y destruidos
+    long long bytesVivos;                                  // bytes en nodos aún vivos
+    uint64_t vecesArchivo[NUM_OPERACIONES_ARCHIVO];        // cargas y guardados
+    uint64_t nsArchivo[NUM_OPERACIONES_ARCHIVO];           // tiempo total en cada una
+
+    EstadisticasListas() { reiniciar(); }
+
+    void reiniciar() {
+        for (int i = 0; i < NUM_OPERACIONES_LISTA; i++) nodosRecorridos[i].reiniciar();
+        reservas = liberaciones = 0;
+        bytesVivos = 0;
+        for (int i = 0; i < NUM_OPERACIONES_ARCHIVO; i++) vecesArchivo[i] = nsArchivo[i] = 0;
+    }
+
+    // Suma las estadísticas de otro hilo (el llamador sincroniza)
+    void combinar(const EstadisticasListas& otro) {
+        for (int i = 0; i < NUM_OPERACIONES_LISTA; i++) nodosRecorridos[i].combinar(otro.nodosRecorridos[i]);
+        reservas += otro.reservas;
+        liberaciones += otro.liberaciones;
+        bytesVivos += otro.bytesVivos;
+        for (int i = 0; i < NUM_OPERACIONES_ARCHIVO; i++) {
+            vecesArchivo[i] += otro.vecesArchivo[i];
+            nsArchivo[i] += otro.nsArchivo[i];
+        }
+    }
+
+    void volcarJSON(ostream& salida) const {
+        static const char* operaciones[] = { "obtenerDato", "modificar", "eliminar", "insertar_pos", "insertar_final", "posicionOrdenada" };
+        static const char* archivo[] = { "carga", "guardado" };
+        salida << "{\n  \"nodos_recorridos\": {\n";
+        for (int i = 0; i < NUM_OPERACIONES_LISTA; i++) {
+            salida << "    \"" << operaciones[i] << "\": ";
+            nodosRecorridos[i].volcarJSON(salida);
+            salida << (i + 1 < NUM_OPERACIONES_LISTA ? ",\n" : "\n");
+        }
+        salida << "  },\n  \"reservas\": " << reservas << ",\n  \"liberaciones\": " << liberaciones
+               << ",\n  \"bytes_vivos\": " << bytesVivos << ",\n  \"archivo\": {";
+        for (int i = 0; i < NUM_OPERACIONES_ARCHIVO; i++) {
+            salida << "\"" << archivo[i] << "\": {\"veces\": " << vecesArchivo[i]
+                   << ", \"ns\": " << nsArchivo[i] << "}" << (i + 1 < NUM_OPERACIONES_ARCHIVO ? ", " : "");
+        }
+        salida << "}\n}\n";
+    }
+};
+
+// Estadísticas del hilo actual
+inline EstadisticasListas& estadisticasListas() {
+    static thread_local EstadisticasListas e;
+    return e;
+}
+
+inline void volcarEstadisticasJSON(ostream& salida) {
+    estadisticasListas().volcarJSON(salida);
+}
+
+// Cronometra un bloque de carga o guardado y lo suma al terminar
+class MedicionArchivo {
+private:
+    OperacionArchivo op;
+    uint64_t inicio;
+
+public:
+    explicit MedicionArchivo(OperacionArchivo op) : op(op), inicio(ahoraNs()) {}
+    ~MedicionArchivo() {
+        EstadisticasListas& e = estadisticasListas();
+        e.vecesArchivo[op]++;
+        e.nsArchivo[op] += ahoraNs() - inicio;
+    }
+};
+
+// -----------------------------------------------------
+// Macros usadas por lista.h, lista_doble.h y los main.cpp
+// -----------------------------------------------------
+#ifdef LISTAS_INSTRUMENTADAS
+#define LISTA_REGISTRAR_RECORRIDO(op, nodos) estadisticasListas().nodosRecorridos[op].registrar((uint64_t)(nodos))
+#define LISTA_REGISTRAR_RESERVA(bytes) \
+    do { EstadisticasListas& e_ = estadisticasListas(); e_.reservas++; e_.bytesVivos += (long long)(bytes); } while (0)
+#define LISTA_REGISTRAR_LIBERACION(bytes) \
+    do { EstadisticasListas& e_ = estadisticasListas(); e_.liberaciones++; e_.bytesVivos -= (long long)(bytes); } while (0)
+#define LISTA_MEDIR_ARCHIVO(op) MedicionArchivo medicionArchivo_(op)
+#endif
+
+// -----------------------------------------------------
+// Estadísticas del árbol rojinegro
+// -----------------------------------------------------
+enum LadoRotacion { ROTACION_IZQUIERDA = 0, ROTACION_DERECHA, NUM_ROTACIONES };
+
+// Los casos de Cormen en cada ajuste (el 2 de la inserción y el 3 de la
+// eliminación desembocan en el siguiente, que también se cuenta)
+enum CasoAjuste {
+    INSERCION_TIO_ROJO = 0, INSERCION_TRIANGULO, INSERCION_LINEA,
+    ELIMINACION_HERMANO_ROJO, ELIMINACION_SOBRINOS_NEGROS, ELIMINACION_SOBRINO_LEJANO_NEGRO,
+    ELIMINACION_SOBRINO_LEJANO_ROJO,
+    NUM_CASOS_AJUSTE
+};
+
+enum AjusteArbol { AJUSTE_INSERCION = 0, AJUSTE_ELIMINACION, NUM_AJUSTES };
+enum DescensoArbol { DESCENSO_BUSQUEDA = 0, DESCENSO_INSERCION, NUM_DESCENSOS };
+
+struct EstadisticasArbol {
+    uint64_t rotaciones[NUM_ROTACIONES];
+    uint64_t recoloreos;                       // colores asignados en los ajustes
+    uint64_t casos[NUM_CASOS_AJUSTE];
+    HistogramaLog2 vueltasAjuste[NUM_AJUSTES]; // vueltas del ciclo por llamada
+    HistogramaLog2 profundidad[NUM_DESCENSOS]; // nodos visitados por descenso
+    uint64_t reservas, liberaciones;           // nodos construidos y destruidos
+    uint64_t bloques;                          // bloques pedidos al sistema
+    long long bytesBloques;
+    uint64_t pasos;                            // del descenso o ajuste en curso
+
+    EstadisticasArbol() { reiniciar(); }
+
+    void reiniciar() {
+        for (int i = 0; i < NUM_ROTACIONES; i++) rotaciones[i] = 0;
+        for (int i = 0; i < NUM_CASOS_AJUSTE; i++) casos[i] = 0;
+        for (int i = 0; i < NUM_AJUSTES; i++) vueltasAjuste[i].reiniciar();
+        for (int i = 0; i < NUM_DESCENSOS; i++) profundidad[i].reiniciar();
+        recoloreos = reservas = liberaciones = bloques = pasos = 0;
+        bytesBloques = 0;
+    }
+
+    // Suma las estadísticas de otro hilo (el llamador sincroniza)
+    void combinar(const EstadisticasArbol& otro) {
+        for (int i = 0; i < NUM_ROTACIONES; i++) rotaciones[i] += otro.rotaciones[i];
+        for (int i = 0; i < NUM_CASOS_AJUSTE; i++) casos[i] += otro.casos[i];
+        for (int i = 0; i < NUM_AJUSTES; i++) vueltasAjuste[i].combinar(otro.vueltasAjuste[i]);
+        for (int i = 0; i < NUM_DESCENSOS; i++) profundidad[i].combinar(otro.profundidad[i]);
+        recoloreos += otro.recoloreos;
+        reservas += otro.reservas;
+        liberaciones += otro.liberaciones;
+        bloques += otro.bloques;
+        bytesBloques += otro.bytesBloques;
+    }
+
+    void volcarJSON(ostream& salida) const {
+        static const char* casosNombres[] = {
+            "insercion_tio_rojo", "insercion_triangulo", "insercion_linea",
+            "eliminacion_hermano_rojo", "eliminacion_sobrinos_negros",
+            "eliminacion_sobrino_lejano_negro", "eliminacion_sobrino_lejano_rojo"
+        };
+        static const char* ajustes[] = { "insercion", "eliminacion" };
+        static const char* descensos[] = { "busqueda", "insercion" };
+        salida << "{\n  \"rotaciones\": {\"izquierda\": " << rotaciones[ROTACION_IZQUIERDA]
+               << ", \"derecha\": " << rotaciones[ROTACION_DERECHA] << "},\n  \"recoloreos\": " << recoloreos
+               << ",\n  \"casos\": {";
+        for (int i = 0; i < NUM_CASOS_AJUSTE; i++)
+            salida << "\"" << casosNombres[i] << "\": " << casos[i] << (i + 1 < NUM_CASOS_AJUSTE ? ", " : "");
+        salida << "},\n  \"vueltas_ajuste\": {\n";
+        for (int i = 0; i < NUM_AJUSTES; i++) {
+            salida << "    \"" << ajustes[i] << "\": ";
+            vueltasAjuste[i].volcarJSON(salida);
+            salida << (i + 1 < NUM_AJUSTES ? ",\n" : "\n");
+        }
+        salida << "  },\n  \"profundidad\": {\n";
+        for (int i = 0; i < NUM_DESCENSOS; i++) {
+            salida << "    \"" << descensos[i] << "\": ";
+            profundidad[i].volcarJSON(salida);
+            salida << (i + 1 < NUM_DESCENSOS ? ",\n" : "\n");
+        }
+        salida << "  },\n  \"reservas\": " << reservas << ",\n  \"liberaciones\": " << liberaciones
+               << ",\n  \"bloques\": " << bloques << ",\n  \"bytes_bloques\": " << bytesBloques << "\n}\n";
+    }
+};
+
+// Estadísticas del árbol en el hilo actual
+inline EstadisticasArbol& estadisticasArbol() {
+    static thread_local EstadisticasArbol e;
+    return e;
+}
+
+inline void volcarEstadisticasArbolJSON(ostream& salida) {
+    estadisticasArbol().volcarJSON(salida);
+}
+
+// -----------------------------------------------------
+// Macros usadas por ArbolRojiNegro.h. Un descenso o un ajuste pone en cero
+// el contador de pasos, lo incrementa en cada nivel o vuelta y al terminar
+// lo registra en su histograma (nunca hay dos en curso en el mismo hilo)
+// -----------------------------------------------------
+#ifdef ARBOL_INSTRUMENTADO
+#define ARBOL_REGISTRAR_ROTACION(lado) estadisticasArbol().rotaciones[lado]++
+#define ARBOL_REGISTRAR_RECOLOREO(n) estadisticasArbol().recoloreos += (n)
+#define ARBOL_REGISTRAR_CASO(caso) estadisticasArbol().casos[caso]++
+#define ARBOL_INICIAR_PASOS() estadisticasArbol().pasos = 0
+#define ARBOL_CONTAR_PASO() estadisticasArbol().pasos++
+#define ARBOL_REGISTRAR_AJUSTE(ajuste) \
+    do { EstadisticasArbol& e_ = estadisticasArbol(); e_.vueltasAjuste[ajuste].registrar(e_.pasos); } while (0)
+#define ARBOL_REGISTRAR_DESCENSO(descenso) \
+    do { EstadisticasArbol& e_ = estadisticasArbol(); e_.profundidad[descenso].registrar(e_.pasos); } while (0)
+#define ARBOL_REGISTRAR_RESERVAS(n) estadisticasArbol().reservas += (n)
+#define ARBOL_REGISTRAR_LIBERACION() estadisticasArbol().liberaciones++
+#define ARBOL_REGISTRAR_BLOQUE(bytes) \
+    do { EstadisticasArbol& e_ = estadisticasArbol(); e_.bloques++; e_.bytesBloques += (long long)(bytes); } while (0)
+#endif
+
+#endif
@@ -0,0 +1,374 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Modo por lotes (no interactivo) para los programas de listas y árboles.
+// Lee un guion de operaciones en texto o un registro binario, lo ejecuta sin
+// menús ni vaciados de salida por operación y reporta ops/s y percentiles de
+// latencia por tipo de operación.
+//
+// Formato de texto (una operación por línea, '#' inicia un comentario):
+//
+//     insertar <arg> <valor...>
+//     modificar <arg> <valor...>
+//     eliminar <arg>
+//     buscar <arg>
+//
+// <arg> es una posición en las listas y una clave en el árbol.
+//
+// Formato binario (registro de operaciones, en el orden de bytes del equipo):
+//
+//     "OPLG" | uint32 versión | uint64 cantidad |
+//     cantidad x ( uint8 tipo | int64 arg | uint32 largo | largo bytes de valor )
+
+#ifndef LOTE_H
+#define LOTE_H
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "medicion.h"
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace std;
+
+// -----------------------------------------------------
+// Definición de la Operación
+// -----------------------------------------------------
+enum TipoOperacion { OP_INSERTAR = 0, OP_MODIFICAR, OP_ELIMINAR, OP_BUSCAR, NUM_TIPOS_OPERACION };
+
+struct Operacion {
+    TipoOperacion tipo;
+    long long arg;   // posición (listas) o clave (árbol)
+    string valor;    // vacío en eliminar y buscar
+};
+
+inline const char* nombreOperacion(TipoOperacion t) {
+    static const char* nombres[] = { "insertar", "modificar", "eliminar", "buscar" };
+    return nombres[t];
+}
+
+inline bool leerTipoOperacion(const string& s, TipoOperacion& t) {
+    for (int i = 0; i < NUM_TIPOS_OPERACION; i++) {
+        if (s == nombreOperacion((TipoOperacion)i) || (s.size() == 1 && s[0] == nombreOperacion((TipoOperacion)i)[0])) {
+            t = (TipoOperacion)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------
+// Lectura y escritura de operaciones
+// -----------------------------------------------------
+static const char MAGIA_REGISTRO[4] = { 'O', 'P', 'L', 'G' };
+static const uint32_t VERSION_REGISTRO = 1;
+
+// Los conteos del registro binario vienen del archivo: no se reserva más de
+// esto por adelantado, y un valor más largo se toma como registro dañado
+static const uint64_t RESERVA_MAXIMA_REGISTRO = 1 << 20;  // operaciones
+static const uint32_t LARGO_MAXIMO_VALOR = 1 << 24;       // bytes (16 MB)
+
+inline void leerOperacionesTexto(istream& entrada, vector<Operacion>& ops) {
+    string linea;
+    int numLinea = 0;
+    while (getline(entrada, linea)) {
+        numLinea++;
+        size_t com = linea.find('#');
+        if (com != string::npos) linea.erase(com);
+        if (!linea.empty() && linea[linea.size() - 1] == '\r') linea.erase(linea.size() - 1);
+
+        stringstream ss(linea);
+        string nombre;
+        if (!(ss >> nombre)) continue; // línea vacía
+
+        Operacion op;
+        if (!leerTipoOperacion(nombre, op.tipo) || !(ss >> op.arg)) {
+            ostringstream msg;
+            msg << "Línea " << numLinea << " inválida: " << linea;
+            throw invalid_argument(msg.str());
+        }
+        ss >> ws;
+        getline(ss, op.valor); // el resto de la línea (puede tener espacios o comas)
+        ops.push_back(op);
+    }
+}
+
+inline void leerOperacionesBinario(istream& entrada, vector<Operacion>& ops) {
+    uint32_t version;
+    uint64_t cantidad;
+    entrada.read((char*)&version, sizeof(version));
+    entrada.read((char*)&cantidad, sizeof(cantidad));
+    if (!entrada || version != VERSION_REGISTRO) throw invalid_argument("Registro binario inválido");
+
+    ops.reserve(ops.size() + (size_t)min(cantidad, RESERVA_MAXIMA_REGISTRO));
+    for (uint64_t i = 0; i < cantidad; i++) {
+        uint8_t tipo;
+        int64_t arg;
+        uint32_t largo;
+        entrada.read((char*)&tipo, sizeof(tipo));
+        entrada.read((char*)&arg, sizeof(arg));
+        entrada.read((char*)&largo, sizeof(largo));
+        if (!entrada || tipo >= NUM_TIPOS_OPERACION) throw invalid_argument("Registro binario truncado");
+        if (largo > LARGO_MAXIMO_VALOR) throw invalid_argument("Registro binario inválido");
+
+        Operacion op;
+        op.tipo = (TipoOperacion)tipo;
+        op.arg = arg;
+        op.valor.resize(largo);
+        if (largo > 0) entrada.read(&op.valor[0], largo);
+        if (!entrada) throw invalid_argument("Registro binario truncado");
+        ops.push_back(op);
+    }
+}
+
+// Detecta el formato por la cabecera "OPLG"
+inline void leerOperaciones(istream& entrada, vector<Operacion>& ops) {
+    char magia[4] = { 0, 0, 0, 0 };
+    entrada.read(magia, 4);
+    if (entrada.gcount() == 4 && memcmp(magia, MAGIA_REGISTRO, 4) == 0) {
+        leerOperacionesBinario(entrada, ops);
+        return;
+    }
+    // No es binario: devolvemos lo leído y lo tratamos como texto
+    string inicio(magia, (size_t)entrada.gcount());
+    entrada.clear();
+    stringstream resto;
+    resto << inicio;
+    if (entrada.peek() != EOF) resto << entrada.rdbuf();
+    leerOperacionesTexto(resto, ops);
+}
+
+// En Windows la entrada y la salida estándar están en modo texto: al
+// escribir cada 0x0A se vuelve CR LF y al leer se quitan los CR y un 0x1A
+// corta el flujo, lo que daña un registro binario. Hay que llamarla antes
+// de leer o escribir nada en el flujo
+inline void modoBinario(FILE* flujo) {
+#if defined(_WIN32)
+    _setmode(_fileno(flujo), _O_BINARY);
+#else
+    (void)flujo;
+#endif
+}
+
+// Lee desde un archivo o desde la entrada estándar si la ruta es "-". Los
+// dos se abren en modo binario; el lector de texto ya descarta los CR
+inline bool cargarOperaciones(const string& ruta, vector<Operacion>& ops) {
+    if (ruta == "-") {
+        modoBinario(stdin);
+        leerOperaciones(cin, ops);
+        return true;
+    }
+    ifstream archivo(ruta.c_str(), ios::binary);
+    if (!archivo.is_open()) {
+        cerr << "No se pudo abrir el archivo: " << ruta << "\n";
+        return false;
+    }
+    leerOperaciones(archivo, ops);
+    return true;
+}
+
+inline void escribirOperacionesTexto(ostream& salida, const vector<Operacion>& ops) {
+    for (size_t i = 0; i < ops.size(); i++) {
+        salida << nombreOperacion(ops[i].tipo) << ' ' << ops[i].arg;
+        if (!ops[i].valor.empty()) salida << ' ' << ops[i].valor;
+        salida << '\n';
+    }
+}
+
+inline void escribirOperacionesBinario(ostream& salida, const vector<Operacion>& ops) {
+    uint64_t cantidad = ops.size();
+    salida.write(MAGIA_REGISTRO, 4);
+    salida.write((const char*)&VERSION_REGISTRO, sizeof(VERSION_REGISTRO));
+    salida.write((const char*)&cantidad, sizeof(cantidad));
+    for (size_t i = 0; i < ops.size(); i++) {
+        uint8_t tipo = (uint8_t)ops[i].tipo;
+        int64_t arg = ops[i].arg;
+        uint32_t largo = (uint32_t)ops[i].valor.size();
+        salida.write((const char*)&tipo, sizeof(tipo));
+        salida.write((const char*)&arg, sizeof(arg));
+        salida.write((const char*)&largo, sizeof(largo));
+        salida.write(ops[i].valor.data(), largo);
+    }
+}
+
+// -----------------------------------------------------
+// Generación de cargas sintéticas
+// -----------------------------------------------------
+struct ParametrosCarga {
+    Distribucion dist;
+    size_t cantidad;    // número de operaciones
+    uint64_t universo;  // claves/posiciones en [0, universo)
+    int porcentaje[NUM_TIPOS_OPERACION]; // mezcla de operaciones, suma 100
+
+    ParametrosCarga() : dist(DIST_UNIFORME), cantidad(1000), universo(1000) {
+        porcentaje[OP_INSERTAR] = 30;
+        porcentaje[OP_MODIFICAR] = 20;
+        porcentaje[OP_ELIMINAR] = 10;
+        porcentaje[OP_BUSCAR] = 40;
+    }
+};
+
+inline vector<Operacion> generarCarga(const ParametrosCarga& p, uint64_t semilla = 42) {
+    GeneradorClaves claves(p.dist, p.universo, semilla);
+    vector<Operacion> ops(p.cantidad);
+    for (size_t i = 0; i < p.cantidad; i++) {
+        int dado = (int)(claves.aleatorio() % 100);
+        int t = 0;
+        while (t < NUM_TIPOS_OPERACION - 1 && dado >= p.porcentaje[t]) {
+            dado -= p.porcentaje[t];
+            t++;
+        }
+        ops[i].tipo = (TipoOperacion)t;
+        ops[i].arg = (long long)claves();
+        if (t == OP_INSERTAR || t == OP_MODIFICAR) {
+            ostringstream valor;
+            valor << claves.aleatorio() % 1000000;
+            ops[i].valor = valor.str();
+        }
+    }
+    return ops;
+}
+
+// Reduce un argumento cualquiera a una posición válida en [0, m)
+inline int posicionEnRango(long long arg, long long m) {
+    return (int)(((arg % m) + m) % m);
+}
+
+// -----------------------------------------------------
+// Ejecución cronometrada y reporte
+// -----------------------------------------------------
+struct ResultadoLote {
+    MuestrasLatencia latencias[NUM_TIPOS_OPERACION];
+    size_t fallidas[NUM_TIPOS_OPERACION]; // no encontradas, fuera de rango o lista vacía
+    uint64_t nsTotales;                   // tiempo de pared de todo el lote
+
+    ResultadoLote() : nsTotales(0) {
+        for (int i = 0; i < NUM_TIPOS_OPERACION; i++) fallidas[i] = 0;
+    }
+};
+
+// aplicar(op) devuelve false si la operación no tuvo efecto. Las excepciones
+// out_of_range e invalid_argument se cuentan como fallidas y no detienen el lote.
+template <class Aplicar>
+ResultadoLote ejecutarLote(const vector<Operacion>& ops, Aplicar aplicar) {
+    ResultadoLote r;
+    uint64_t inicioLote = ahoraNs();
+    for (size_t i = 0; i < ops.size(); i++) {
+        const Operacion& op = ops[i];
+        bool ok;
+        uint64_t t0 = ahoraNs();
+        try {
+            ok = aplicar(op);
+        } catch (out_of_range&) {
+            ok = false;
+        } catch (invalid_argument&) {
+            ok = false;
+        }
+        r.latencias[op.tipo].agregar(ahoraNs() - t0);
+        if (!ok) r.fallidas[op.tipo]++;
+    }
+    r.nsTotales = ahoraNs() - inicioLote;
+    return r;
+}
+
+inline void imprimirReporte(ostream& salida, ResultadoLote& r) {
+    size_t total = 0;
+    salida << left << setw(10) << "operacion" << right
+           << setw(10) << "total" << setw(10) << "fallidas" << setw(14) << "ops/s"
+           << setw(10) << "p50(ns)" << setw(10) << "p90(ns)" << setw(10) << "p99(ns)"
+           << setw(12) << "p99.9(ns)" << setw(12) << "max(ns)" << '\n';
+    for (int t = 0; t < NUM_TIPOS_OPERACION; t++) {
+        MuestrasLatencia& m = r.latencias[t];
+        total += m.cantidad();
+        if (m.cantidad() == 0) continue;
+        salida << left << setw(10) << nombreOperacion((TipoOperacion)t) << right
+               << setw(10) << m.cantidad() << setw(10) << r.fallidas[t]
+               << setw(14) << fixed << setprecision(0) << m.opsPorSegundo()
+               << setw(10) << m.percentil(50) << setw(10) << m.percentil(90)
+               << setw(10) << m.percentil(99) << setw(12) << m.percentil(99.9)
+               << setw(12) << m.percentil(100) << '\n';
+    }
+    double segundos = r.nsTotales / 1e9;
+    salida << "Total: " << total << " operaciones en " << setprecision(3) << segundos << " s ("
+           << setprecision(0) << (segundos > 0 ? total / segundos : 0.0) << " ops/s)\n";
+}
+
+// -----------------------------------------------------
+// Línea de comandos común
+// -----------------------------------------------------
+//
+//     programa --lote <archivo|->
+//     programa --generar <uniforme|zipf|secuencial> <n> [--universo U]
+//              [--mezcla I,M,E,B] [--binario] [--semilla S]
+//
+// --generar escribe el guion en la salida estándar.
+
+// Busca "--opcion valor" en argv; devuelve NULL si no está
+inline const char* valorOpcion(int argc, char* argv[], const char* opcion) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], opcion) == 0) return argv[i + 1];
+    return NULL;
+}
+
+inline bool tieneOpcion(int argc, char* argv[], const char* opcion) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], opcion) == 0) return true;
+    return false;
+}
+
+inline int generarCargaCLI(int argc, char* argv[]) {
+    const char* dist = valorOpcion(argc, argv, "--generar");
+    ParametrosCarga p;
+    int pos = 0;
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], "--generar") == 0) pos = i;
+
+    if (dist == NULL || pos + 2 >= argc || !leerDistribucion(dist, p.dist)) {
+        cerr << "Uso: --generar <uniforme|zipf|secuencial> <n> [--universo U] "
+                "[--mezcla I,M,E,B] [--binario] [--semilla S]\n";
+        return 1;
+    }
+    p.cantidad = (size_t)strtoull(argv[pos + 2], NULL, 10);
+    p.universo = p.cantidad;
+    if (const char* u = valorOpcion(argc, argv, "--universo")) p.universo = strtoull(u, NULL, 10);
+    if (const char* m = valorOpcion(argc, argv, "--mezcla")) {
+        char coma;
+        stringstream ss(m);
+        int suma = 0;
+        for (int t = 0; t < NUM_TIPOS_OPERACION; t++) {
+            ss >> p.porcentaje[t];
+            suma += p.porcentaje[t];
+            if (t < NUM_TIPOS_OPERACION - 1) ss >> coma;
+        }
+        if (!ss || suma != 100) {
+            cerr << "La mezcla debe tener 4 porcentajes que sumen 100\n";
+            return 1;
+        }
+    }
+    uint64_t semilla = 42;
+    if (const char* s = valorOpcion(argc, argv, "--semilla")) semilla = strtoull(s, NULL, 10);
+
+    vector<Operacion> ops = generarCarga(p, semilla);
+    if (tieneOpcion(argc, argv, "--binario")) {
+        modoBinario(stdout);
+        escribirOperacionesBinario(cout, ops);
+    } else {
+        escribirOperacionesTexto(cout, ops);
+    }
+    cout.flush();
+    return 0;
+}
+
+#endif
@@ -0,0 +1,282 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Utilidades de medición compartidas por los programas de listas y árboles:
+// cronómetro, percentiles de latencia y generadores de claves sintéticas
+// (uniforme, zipfiana y secuencial), y fallos de caché con los contadores
+// de hardware cuando el sistema los ofrece.
+
+#ifndef MEDICION_H
+#define MEDICION_H
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>   // enlazar con -lpsapi
+#else
+#include <cstdio>
+#include <sys/resource.h>
+#endif
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// -----------------------------------------------------
+// Reloj monotónico en nanosegundos
+// -----------------------------------------------------
+inline uint64_t ahoraNs() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Evita que el compilador descarte un resultado que solo se mide
+template <class T>
+inline void noOptimizar(const T& valor) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&valor) : "memory");
+#else
+    static const void* volatile sumidero;
+    sumidero = &valor;
+#endif
+}
+
+// -----------------------------------------------------
+// Memoria residente máxima (pico de RSS) del proceso
+// -----------------------------------------------------
+inline long picoMemoriaKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return (long)(pmc.PeakWorkingSetSize / 1024);
+    return -1;
+#else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+#if defined(__APPLE__)
+    return uso.ru_maxrss / 1024; // macOS lo reporta en bytes
+#else
+    return uso.ru_maxrss;        // Linux lo reporta en KB
+#endif
+#endif
+}
+
+// Reinicia el pico de RSS cuando el sistema lo permite (Linux >= 4.0);
+// en los demás el pico es el del proceso completo.
+inline void reiniciarPicoMemoria() {
+#if defined(__linux__)
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+}
+
+// Pico de RSS leído de /proc cuando está disponible (respeta el reinicio)
+inline long picoMemoriaActualKB() {
+#if defined(__linux__)
+    FILE* f = fopen("/proc/self/status", "r");
+    if (f) {
+        char linea[256];
+        long kb = -1;
+        while (fgets(linea, sizeof(linea), f))
+            if (sscanf(linea, "VmHWM: %ld kB", &kb) == 1) break;
+        fclose(f);
+        if (kb >= 0) return kb;
+    }
+#endif
+    return picoMemoriaKB();
+}
+
+// -----------------------------------------------------
+// Fallos de caché del hilo que mide (perf_event_open)
+// -----------------------------------------------------
+// Solo en Linux, y solo si el núcleo deja abrir el contador (perf_event_paranoid,
+// máquinas virtuales sin PMU...). Si no, disponible() es false y detener()
+// devuelve -1, así que los programas reportan -1 en lugar de fallar.
+class ContadorFallosCache {
+private:
+    int fd;
+
+public:
+    ContadorFallosCache() : fd(-1) {
+#if defined(__linux__)
+        struct perf_event_attr atributos;
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.type = PERF_TYPE_HARDWARE;
+        atributos.size = sizeof(atributos);
+        atributos.config = PERF_COUNT_HW_CACHE_MISSES; // fallos del último nivel
+        atributos.disabled = 1;
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &atributos, 0, -1, -1, 0);
+#endif
+    }
+
+    ~ContadorFallosCache() {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool disponible() const { return fd >= 0; }
+
+    void iniciar() {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Fallos desde iniciar(), o -1 sin contador
+    long long detener() {
+#if defined(__linux__)
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long cuenta = 0;
+        if (read(fd, &cuenta, sizeof(cuenta)) != (ssize_t)sizeof(cuenta)) return -1;
+        return cuenta;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    ContadorFallosCache(const ContadorFallosCache&);            // no copiable
+    ContadorFallosCache& operator=(const ContadorFallosCache&);
+};
+
+// -----------------------------------------------------
+// Muestras de latencia con cálculo de percentiles
+// -----------------------------------------------------
+class MuestrasLatencia {
+private:
+    vector<uint64_t> muestras; // latencias en ns
+    uint64_t total;            // suma de todas las muestras
+    bool ordenadas;
+
+public:
+    MuestrasLatencia() : total(0), ordenadas(true) {}
+
+    void agregar(uint64_t ns) {
+        muestras.push_back(ns);
+        total += ns;
+        ordenadas = false;
+    }
+
+    size_t cantidad() const { return muestras.size(); }
+    uint64_t totalNs() const { return total; }
+
+    // Percentil p en [0, 100] por el método del rango más cercano
+    uint64_t percentil(double p) {
+        if (muestras.empty()) return 0;
+        if (!ordenadas) {
+            sort(muestras.begin(), muestras.end());
+            ordenadas = true;
+        }
+        size_t idx = (size_t)ceil(p / 100.0 * muestras.size());
+        if (idx > 0) idx--; // el rango es 1-indexado
+        if (idx >= muestras.size()) idx = muestras.size() - 1;
+        return muestras[idx];
+    }
+
+    // Operaciones por segundo según el tiempo acumulado
+    double opsPorSegundo() const {
+        return total == 0 ? 0.0 : muestras.size() * 1e9 / (double)total;
+    }
+};
+
+// -----------------------------------------------------
+// Generadores de claves sintéticas en [0, n)
+// -----------------------------------------------------
+enum Distribucion { DIST_UNIFORME, DIST_ZIPF, DIST_SECUENCIAL };
+
+inline bool leerDistribucion(const string& nombre, Distribucion& d) {
+    if (nombre == "uniforme") d = DIST_UNIFORME;
+    else if (nombre == "zipf" || nombre == "zipfiana") d = DIST_ZIPF;
+    else if (nombre == "secuencial") d = DIST_SECUENCIAL;
+    else return false;
+    return true;
+}
+
+// Generador zipfiano de Gray et al. ("Quickly Generating Billion-Record
+// Synthetic Databases"), el mismo que usa YCSB. Los valores pequeños son
+// los más frecuentes: el 0 es el más "caliente".
+class GeneradorZipf {
+private:
+    uint64_t n;
+    double theta, alfa, zetan, eta;
+
+    static double zeta(uint64_t n, double theta) {
+        double suma = 0;
+        for (uint64_t i = 1; i <= n; i++)
+            suma += 1.0 / pow((double)i, theta);
+        return suma;
+    }
+
+public:
+    GeneradorZipf(uint64_t n, double theta = 0.99) : n(n), theta(theta) {
+        double zeta2 = zeta(2, theta);
+        zetan = zeta(n, theta);
+        alfa = 1.0 / (1.0 - theta);
+        eta = (1 - pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    template <class Motor>
+    uint64_t operator()(Motor& motor) {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(motor);
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, theta)) return 1;
+        uint64_t v = (uint64_t)(n * pow(eta * u - eta + 1, alfa));
+        return v >= n ? n - 1 : v;
+    }
+};
+
+// Fachada única sobre las tres distribuciones
+class GeneradorClaves {
+private:
+    Distribucion dist;
+    uint64_t n;
+    uint64_t siguiente;  // estado de la secuencial
+    mt19937_64 motor;
+    GeneradorZipf* zipf; // solo se construye si se pide zipf (zeta es O(n))
+
+public:
+    GeneradorClaves(Distribucion d, uint64_t n, uint64_t semilla = 42)
+        : dist(d), n(n == 0 ? 1 : n), siguiente(0), motor(semilla), zipf(NULL) {
+        if (dist == DIST_ZIPF) zipf = new GeneradorZipf(this->n);
+    }
+
+    ~GeneradorClaves() { delete zipf; }
+
+    uint64_t operator()() {
+        switch (dist) {
+            case DIST_SECUENCIAL: return siguiente++ % n;
+            case DIST_ZIPF:       return (*zipf)(motor);
+            default:              return uniform_int_distribution<uint64_t>(0, n - 1)(motor);
+        }
+    }
+
+    // Número aleatorio auxiliar (mezcla de operaciones, valores, etc.)
+    uint64_t aleatorio() { return motor(); }
+
+private:
+    GeneradorClaves(const GeneradorClaves&);            // no copiable
+    GeneradorClaves& operator=(const GeneradorClaves&);
+};
+
+#endif
@@ -0,0 +1,157 @@
+// Universidad Distrital Francisco José de Caldas
+//
+// Hecho por: Nicolás Martínez Pineda && Ian Nicolás Sandoval Martínez
+//
+// Pool de hilos para algoritmos de divide y vencerás (fork-join).
+//
+// dividir(f1, f2) ejecuta f1 y f2, posiblemente en paralelo, y vuelve
+// cuando ambas terminaron:
+// - f2 se publica en la cola del pool y f1 corre en el hilo que llama.
+// - Al terminar f1, si nadie tomó f2 la corre el mismo hilo; si otro hilo la
+//   tomó, mientras espera ejecuta otras tareas pendientes en vez de
+//   bloquearse. Así una recursión profunda nunca deja al pool sin hilos
+//   libres (no hay interbloqueo aunque todos esperen a sus hijas).
+// - Si f1 o f2 lanzan, la excepción sale de dividir en el hilo que llama,
+//   como si hubieran corrido en orden: una excepción de f2 se guarda en su
+//   tarea y se relanza allí. Si f1 lanza y nadie tomó f2, f2 no corre; si
+//   otro hilo ya la tomó, dividir espera a que termine antes de relanzar
+//   (la tarea vive en la pila de dividir).
+// Los hilos del pool toman las tareas más antiguas (las más grandes de la
+// recursión); el hilo que espera toma las más recientes.
+//
+// Cualquier clase con el mismo dividir(f1, f2) sirve como "ejecutor" para
+// las operaciones en paralelo de las estructuras (ver EjecucionSecuencial en
+// ArbolRojiNegro.h).
+
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class PoolHilos {
+private:
+    struct Tarea {
+        function<void()> trabajo;
+        atomic<bool> hecha;
+        exception_ptr error;   // lo que lanzó trabajo, para quien espera
+    };
+
+    deque<Tarea*> tareas;
+    mutex candado;
+    condition_variable hayTareas;
+    vector<thread> hilos;
+    bool terminar;
+
+    void correr(Tarea* t) {
+        try {
+            t->trabajo();
+        } catch (...) {
+            t->error = current_exception();
+        }
+        t->hecha.store(true, memory_order_release);
+    }
+
+    // Ejecuta la tarea más reciente, si hay alguna
+    bool ayudar() {
+        Tarea* t;
+        {
+            lock_guard<mutex> guardia(candado);
+            if (tareas.empty()) return false;
+            t = tareas.back();
+            tareas.pop_back();
+        }
+        correr(t);
+        return true;
+    }
+
+    void trabajador() {
+        while (true) {
+            Tarea* t;
+            {
+                unique_lock<mutex> guardia(candado);
+                while (!terminar && tareas.empty()) hayTareas.wait(guardia);
+                if (terminar) return;
+                t = tareas.front();
+                tareas.pop_front();
+            }
+            correr(t);
+        }
+    }
+
+public:
+    // Con 0 hilos todo corre en el hilo que llama
+    explicit PoolHilos(unsigned numHilos = thread::hardware_concurrency()) : terminar(false) {
+        // El hilo que llama también trabaja mientras espera
+        for (unsigned i = 1; i < numHilos; i++) hilos.push_back(thread(&PoolHilos::trabajador, this));
+    }
+
+    // Sin dividir en curso
+    ~PoolHilos() {
+        {
+            lock_guard<mutex> guardia(candado);
+            terminar = true;
+        }
+        hayTareas.notify_all();
+        for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+    }
+
+    unsigned getHilos() const { return (unsigned)hilos.size() + 1; }
+
+    template <class F1, class F2>
+    void dividir(F1 f1, F2 f2) {
+        if (hilos.empty()) {
+            f1();
+            f2();
+            return;
+        }
+        Tarea t;
+        t.trabajo = f2;
+        t.hecha.store(false, memory_order_relaxed);
+        {
+            lock_guard<mutex> guardia(candado);
+            tareas.push_back(&t);
+        }
+        hayTareas.notify_one();
+
+        exception_ptr errorF1;
+        try {
+            f1();
+        } catch (...) {
+            errorF1 = current_exception();
+        }
+
+        // Si f2 sigue en la cola es la última publicada: la corremos aquí
+        // (o, si f1 lanzó, la descartamos)
+        bool propia = false;
+        {
+            lock_guard<mutex> guardia(candado);
+            if (!tareas.empty() && tareas.back() == &t) {
+                tareas.pop_back();
+                propia = true;
+            }
+        }
+        if (propia) {
+            if (errorF1) rethrow_exception(errorF1);
+            correr(&t);
+        } else {
+            while (!t.hecha.load(memory_order_acquire))
+                if (!ayudar()) this_thread::yield();
+            if (errorF1) rethrow_exception(errorF1);
+        }
+        if (t.error) rethrow_exception(t.error);
+    }
+
+private:
+    PoolHilos(const PoolHilos&);            // no copiable
+    PoolHilos& operator=(const PoolHilos&);
+};
+
+#endif